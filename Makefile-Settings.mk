@@ -2,7 +2,7 @@
 # @Author:   Ben Sokol <Ben>
 # @Email:    ben@bensokol.com
 # @Created:  February 14th, 2019 [5:21pm]
-# @Modified: February 22nd, 2019 [11:46pm]
+# @Modified: October 19th, 2026 [1:30am]
 # @Version:  1.0.0
 #
 # Copyright (C) 2019 by Ben Sokol. All Rights Reserved.
@@ -36,6 +36,13 @@ MAKEFILE_RULE_UNINSTALL_DISABLE = 1
 
 #ENABLE_LOGGING = 1
 
+# Count heap allocations per phase, and abort on the first allocation made during a battle turn
+#ENABLE_ALLOCATION_TRACKING = 1
+ifdef ENABLE_ALLOCATION_TRACKING
+CFLAGS += -DENABLE_ALLOCATION_TRACKING -DALLOCATION_TRACKING_ABORT
+CXXFLAGS += -DENABLE_ALLOCATION_TRACKING -DALLOCATION_TRACKING_ABORT
+endif
+
 CPPCHECK_DEFINES = -D__cplusplus -DENABLE_LOGGING
 CPPCHECK_SUPPRESS = --suppress=unmatchedSuppression --suppress=missingIncludeSystem --suppress=preprocessorErrorDirective:submodules/utilities/UTL_textWrap.cpp:17
 CPPCHECK_FLAGS = -q --platform=native --error-exitcode=1 --force --std=c11 --std=c++11
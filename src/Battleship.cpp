@@ -3,13 +3,13 @@
 * @Author:   Ben Sokol
 * @Email:    ben@bensokol.com
 * @Created:  February 13th, 2019 [11:01am]
-* @Modified: February 22nd, 2019 [11:47pm]
+* @Modified: October 19th, 2026 [1:45am]
 * @Version:  1.0.0
 *
 * Copyright (C) 2019 by Ben Sokol. All Rights Reserved.
 */
 
-#include <algorithm>    // find_if
+#include <algorithm>    // find_if, std::min, std::max
 #include <chrono>       // std::chrono, std::chrono::duration_cast, std::chrono::high_resolution_clock
 #include <cstdlib>      // size_t
 #include <fstream>      // std::ofstream
@@ -17,14 +17,19 @@
 #include <iostream>     // std::cout
 #include <memory>       // std::unique_ptr
 #include <mutex>        // std::recursive_mutex
+#include <numeric>      // std::iota
 #include <random>       // std::random_device
 #include <string>       // std::string, std::stoull
 #include <sys/errno.h>  // errno
 #include <sys/stat.h>   // mkdir
 #include <vector>       // std::vector
 
+#include "BattleshipAllocations.hpp"
+#include "BattleshipBarrier.hpp"
+#include "BattleshipLazyBoard.hpp"
 #include "BattleshipPlayer.hpp"
-#include "TS_latch.hpp"
+#include "BattleshipTrace.hpp"
+#include "BattleshipWorkerPool.hpp"
 #include "TS_log.hpp"
 #include "TS_logAndPrint.hpp"
 #include "TS_print.hpp"
@@ -35,30 +40,157 @@
 #include "Battleship.hpp"
 
 
+namespace {
+  const char *ENGINE_NAMES[Battleship::ENGINE_COUNT] = { "threaded", "sequential", "lockstep" };
+  const char *STORAGE_NAMES[BattleshipBoard::STORAGE_COUNT] = { "eager", "lazy" };
+
+  // --view frames are at most 1 ms apart
+  const size_t MAX_VIEW_FPS = 1000;
+
+  // A comma separated list of player numbers, such as 0,5,9
+  bool parsePlayerList(const std::string &aValue, std::vector<size_t> &aPlayers) {
+    aPlayers.clear();
+    size_t begin = 0;
+    while (begin <= aValue.size()) {
+      const size_t end = std::min(aValue.find(',', begin), aValue.size());
+      const std::string player = aValue.substr(begin, end - begin);
+      if (!UTL::isNumber(player, 0)) {
+        return false;
+      }
+      aPlayers.push_back(std::stoull(player));
+      begin = end + 1;
+    }
+    return !aPlayers.empty();
+  }
+}  // namespace
+
+
 /****************************************************************
 * Battleship (Constructor):
-*
+*   Defaults for every parameter, the public constructors delegate
+*   here before filling them in.
 ****************************************************************/
-Battleship::Battleship(const int argc, const char *argv[])
-    : mVersionMajor(1), mVersionMinor(0), mVersionBug(0), mDone(false), mNumThreads(0), mSize(0), mTargets(0) {
+Battleship::Battleship()
+    : mSilent(false),
+      mVersionMajor(1),
+      mVersionMinor(0),
+      mVersionBug(0),
+      mNumWorkers(0),
+      mDone(false),
+      mRevives(0),
+      mReviveLatencies(0),
+      mReviveLatencyNanoseconds(0),
+      mReviveLatencyMax(0),
+      mReviveOdds(10),
+      mReviveBelow(50),
+      mNodeId(0),
+      mNetworkBatchSize(64),
+      mLocalBegin(0),
+      mLocalEnd(0),
+      mAliveCount(0),
+      mNumArenas(1),
+      mArenasRemaining(0),
+      mSeed(0),
+      mCheckpointInterval(10),
+      mCheckpointSequence(0),
+      mCheckpointPending(false),
+      mCheckpointParked(0),
+      mCountersEnabled(false),
+      mAttackBatch(1),
+      mTryLockTargeting(false),
+      mEngine(ENGINE_THREADED),
+      mLockstepRounds(0),
+      mGames(0),
+      mGamesWidth(BattleshipGames::detect()),
+      mGamesResult(),
+      mPages(BattleshipMemory::PAGES_HEAP),
+      mBoards(BattleshipBoard::STORAGE_EAGER),
+      mSweepFile(),
+      mSweepCores(0),
+      mSweepJson(false),
+      mMonitorInterval(0),
+      mMonitorDone(false),
+      mMonitorSnapshots(0),
+      mMonitorNanoseconds(0),
+      mViewPlayers(),
+      mViewFps(30),
+      mViewDone(false),
+      mViewFrames(0),
+      mViewCells(0),
+      mViewBytes(0),
+      mViewNanoseconds(0),
+      mEstimate(false),
+      mStartResources(),
+      mInitResources(),
+      mBattleResources(),
+      mReportResources(),
+      mTraceSample(1),
+      mNumThreads(0),
+      mSize(0),
+      mTargets(0),
+      mWinner(std::numeric_limits<size_t>::max()) {
   mValidInputParameters = true;
-  if (!initParameters(argc, argv)) {
+}
+
+
+/****************************************************************
+* Battleship (Constructor):
+*
+****************************************************************/
+Battleship::Battleship(const int argc, const char *argv[]) : Battleship() {
+  // A sweep builds a Battleship for each of its games
+  if (!initParameters(argc, argv) || mEstimate || mSweep) {
     return;
   }
 
 #ifdef ENABLE_LOGGING
   createLogFile();
 #endif
+  initEngine();
+}
+
+
+/****************************************************************
+* initEngine:
+*   Everything sized by the validated parameters.
+****************************************************************/
+void Battleship::initEngine() {
+  // Each node owns a contiguous shard of the players
+  mLocalBegin = 0;
+  mLocalEnd = mNumThreads;
+  if (!mPeers.empty()) {
+    mNetwork = std::unique_ptr<BattleshipNetwork>(new BattleshipNetwork(mNodeId, mPeers, mNetworkBatchSize));
+    mLocalBegin = (mNumThreads * mNodeId) / mPeers.size();
+    mLocalEnd = (mNumThreads * (mNodeId + 1)) / mPeers.size();
+    mAliveView = std::vector<std::atomic<bool>>(mNumThreads);
+    for (auto &alive : mAliveView) {
+      alive.store(true);
+    }
+    mAliveCount.store(mNumThreads);
+    mInFlight = std::vector<std::atomic<size_t>>(mNumThreads);
+  }
+
+  mNumWorkers = workerCount(mLocalEnd - mLocalBegin);
 
-  mThreads = std::vector<std::future<void>>(mNumThreads);
   mMtx = std::vector<std::recursive_mutex>(MTX_COUNT);
   mPlayerMtx = std::vector<std::mutex>(mNumThreads);
-  mPlayers = std::vector<std::shared_ptr<BattleshipPlayer>>(mNumThreads);
-  mCvs = std::vector<std::condition_variable>(mNumThreads);
-  mRevivePlayer = std::vector<bool>(mNumThreads, false);
-  mBegin = std::unique_ptr<TS::Latch>(new TS::Latch(mNumThreads));
-  mWinner = std::numeric_limits<size_t>::max();
-  TS::logAndPrint(mLogFile, mMtx[COUT], mMtx[LOG], "Battleship Simulation Initialized...\n");
+  mWorkerMtx = std::vector<std::mutex>(mNumWorkers);
+  mPlayers = std::vector<std::unique_ptr<BattleshipPlayer>>(mNumThreads);
+  mCvs = std::vector<std::condition_variable>(mNumWorkers);
+  mRevived = std::vector<revived_t>(mNumWorkers);
+  for (revived_t &revived : mRevived) {
+    revived.players.reserve((mLocalEnd - mLocalBegin) / mNumWorkers + 1);
+    revived.taken.reserve((mLocalEnd - mLocalBegin) / mNumWorkers + 1);
+  }
+  mRevivedAt = std::vector<std::atomic<uint64_t>>(mNumThreads);
+  for (auto &revivedAt : mRevivedAt) {
+    revivedAt.store(0);
+  }
+  mRngs = std::vector<BattleshipRandom>(mNumThreads);
+  mArenaOfPlayer = std::vector<size_t>(mNumThreads, NO_ARENA);
+  mTargeting = std::vector<targeting_t>(mNumWorkers);
+  mBegin = std::unique_ptr<BattleshipBarrier>(new BattleshipBarrier(mNumWorkers));
+  logAndPrint("Battleship Simulation Initialized...\n");
 }
 
 /****************************************************************
@@ -71,9 +203,6 @@ Battleship::~Battleship() {
     TS::log(mLogFile, mMtx[LOG], "\nFinished Battleship Program.\n\nEnd Log.\n");
   }
 #endif
-  for (auto &thread : mThreads) {
-    thread.wait();
-  }
 }
 
 
@@ -82,70 +211,340 @@ Battleship::~Battleship() {
 *
 ****************************************************************/
 bool Battleship::initParameters(const int &argc, const char *argv[]) {
-  // Check number of arguments, print version or help as necessary
-  if (argc != 4) {
-    mValidInputParameters = false;
-    if (argc == 2) {
-      if (std::string(argv[1]).compare("--version") == 0 || std::string(argv[1]).compare("-v") == 0) {
-        printVersion();
-        return false;
-      }
-      else if (std::string(argv[1]).compare("--help") == 0 || std::string(argv[1]).compare("-h") == 0) {
-        printHelp();
+  // Print version or help as necessary
+  if (argc == 2) {
+    if (std::string(argv[1]).compare("--version") == 0 || std::string(argv[1]).compare("-v") == 0) {
+      mValidInputParameters = false;
+      printVersion();
+      return false;
+    }
+    else if (std::string(argv[1]).compare("--help") == 0 || std::string(argv[1]).compare("-h") == 0) {
+      mValidInputParameters = false;
+      printHelp();
+      return false;
+    }
+  }
+
+  // Separate options from P N M
+  std::vector<const char *> args;
+  std::vector<std::string> options;
+  for (int i = 1; i < argc; ++i) {
+    if (std::string(argv[i]).compare("--resume") == 0 && i + 1 < argc) {
+      mResumeFile = argv[++i];
+      options.push_back("--resume");
+    }
+    else if (std::string(argv[i]).compare(0, 2, "--") == 0) {
+      if (!initOption(argv[i])) {
+        mValidInputParameters = false;
         return false;
       }
+      options.push_back(std::string(argv[i]).substr(0, std::string(argv[i]).find('=')));
     }
-    std::cout << UTL::COLOR_RED_BOLD << "ERROR" << UTL::COLOR_RESET << ": Invalid Command Line Arguments\n"
-              << "       For help, ./battleship --help\n";
-    return false;
+    else {
+      args.push_back(argv[i]);
+    }
+  }
+
+  // Every game of a sweep is described by its scenario file
+  const bool sweepOnly = std::all_of(options.begin(), options.end(), [](const std::string &option) {
+    return option == "--sweep" || option == "--cores" || option == "--format";
+  });
+  if (!mSweepFile.empty()) {
+    if (!args.empty() || !sweepOnly) {
+      return invalidParameters("--sweep only takes --cores and --format, the rest is read from the scenario file");
+    }
+    return loadSweep();
+  }
+  if (std::any_of(options.begin(), options.end(),
+                  [](const std::string &option) { return option == "--cores" || option == "--format"; })) {
+    return invalidParameters("--cores and --format are only used by --sweep");
+  }
+
+  // P N M come from the checkpoint when resuming
+  if (!mResumeFile.empty()) {
+    if (!args.empty()) {
+      return invalidParameters("P, N and M are read from the checkpoint when resuming");
+    }
+    if (!loadCheckpoint()) {
+      return false;
+    }
+    return validateParameters();
+  }
+
+  // Check number of arguments
+  if (args.size() != 3) {
+    return invalidParameters("Invalid Command Line Arguments");
   }
 
   // Validate all arguments are numbers
-  if (UTL::isNumber(argv[1], 2)) {
-    mNumThreads = std::stoull(argv[1]);
+  if (!UTL::isNumber(args[0], 2)) {
+    return invalidParameters("Failed input validation. P must be greater than or equal to 2");
   }
-  else {
-    std::cout << UTL::COLOR_RED_BOLD << "ERROR" << UTL::COLOR_RESET
-              << ": Failed input validation. P must be greater than or equal to 2\n"
-              << "       For help, ./battleship --help\n";
-    mValidInputParameters = false;
-    return false;
+  mNumThreads = std::stoull(args[0]);
+
+  // Coordinates hold a row or column in 16 bits
+  if (!UTL::isNumber(args[1], 0) || std::stoull(args[1]) > BattleshipBoard::coordinate_t::MAX_LINES) {
+    return invalidParameters("Failed input validation. N must be greater than 0 and at most 65535");
   }
+  mSize = std::stoull(args[1]);
 
-  if (UTL::isNumber(argv[2], 0)) {
-    mSize = std::stoull(argv[2]);
+  if (!UTL::isNumber(args[2], 0)) {
+    return invalidParameters("Failed input validation. M must be greater than 0");
   }
-  else {
-    std::cout << UTL::COLOR_RED_BOLD << "ERROR" << UTL::COLOR_RESET
-              << ": Failed input validation. N must be greater than 0\n"
-              << "       For help, ./battleship --help\n";
-    mValidInputParameters = false;
-    return false;
+  mTargets = std::stoull(args[2]);
+
+  return validateParameters();
+}
+
+
+/****************************************************************
+* validateParameters:
+*   Checks shared by the command line and config_t, once P, N, M
+*   and the options are set.
+****************************************************************/
+bool Battleship::validateParameters() {
+  // Distributed mode does not support checkpoints
+  if (!mPeers.empty() && (!mCheckpointFile.empty() || !mResumeFile.empty())) {
+    return invalidParameters("Checkpoints are not supported in distributed mode");
   }
 
-  if (UTL::isNumber(argv[3], 0)) {
-    mTargets = std::stoull(argv[3]);
+  // Tournament rounds are not distributed or checkpointed
+  if (mNumArenas > 1 && (!mPeers.empty() || !mCheckpointFile.empty() || !mResumeFile.empty())) {
+    return invalidParameters("Tournament mode does not support distributed mode or checkpoints");
   }
-  else {
-    std::cout << UTL::COLOR_RED_BOLD << "ERROR" << UTL::COLOR_RESET
-              << ": Failed input validation. M must be greater than 0\n"
-              << "       For help, ./battleship --help\n";
-    mValidInputParameters = false;
-    return false;
+
+  // The sequential engine takes no locks and the lockstep engine owns the order of every attack, so nothing else
+  // may touch the players during the battle
+  if (mEngine != ENGINE_THREADED && (!mPeers.empty() || !mCheckpointFile.empty() || mTryLockTargeting)) {
+    return invalidParameters(std::string("The ") + ENGINE_NAMES[mEngine]
+                             + " engine does not support distributed mode, checkpoints or try-lock targeting");
   }
 
-  // Validate input value
-  if (mValidInputParameters && (mTargets > (mSize * mSize))) {
-    std::cout << UTL::COLOR_RED_BOLD << "ERROR" << UTL::COLOR_RESET
-              << ": Failed input validation. M must be less than or equal to N²\n"
-              << "       For help, ./battleship --help\n";
-    mValidInputParameters = false;
-    return false;
+  // Games follow the sequential engine's rules for two players, on boards that fit in a word
+  if (mGames > 0
+      && (mNumThreads != 2 || mSize > BattleshipGames::MAX_SIZE || mTargets == 0 || mNumArenas > 1 || mAttackBatch > 1
+          || mTryLockTargeting || mEngine == ENGINE_LOCKSTEP || !mPeers.empty() || !mCheckpointFile.empty()
+          || !mResumeFile.empty() || mMonitorInterval > 0 || !mViewPlayers.empty() || mCountersEnabled
+          || !mTraceFile.empty())) {
+    return invalidParameters("--games needs P = 2, N≤8 and M>0, without --arenas, --attack-batch, --targeting, "
+                             "--engine=lockstep, --monitor, --view, --counters, --trace, checkpoints or distributed "
+                             "mode");
+  }
+
+  // The view owns the terminal during the battle, and only draws local players
+  if (!mViewPlayers.empty() && (mMonitorInterval > 0 || !mPeers.empty())) {
+    return invalidParameters("--view does not support --monitor or distributed mode");
+  }
+  for (size_t player : mViewPlayers) {
+    if (player >= mNumThreads || std::count(mViewPlayers.begin(), mViewPlayers.end(), player) > 1) {
+      return invalidParameters("Failed input validation. --view must list distinct players below P");
+    }
+  }
+
+  // Players and boards are allocated once this is set
+  if (!BattleshipMemory::configure(mPages)) {
+    return invalidParameters("--huge-pages is only supported on Linux");
+  }
+
+  // Validate input value, a resumed game's come from the checkpoint header
+  if (mTargets > (mSize * mSize)) {
+    return invalidParameters("Failed input validation. M must be less than or equal to N²");
+  }
+
+  // Pick a seed unless one was given or resumed
+  if (mSeed == 0 && mResumeFile.empty()) {
+    std::random_device rd;
+    mSeed = (static_cast<uint64_t>(rd()) << 32) ^ rd();
+  }
+
+  // Lazy boards pack a cell index in 30 bits
+  if (mBoards == BattleshipBoard::STORAGE_LAZY && mSize > BattleshipLazyBoard::MAX_LINES) {
+    return invalidParameters("Failed input validation. --boards=lazy needs N≤32767");
+  }
+
+  // Validate tournament mode
+  if (mNumArenas > mNumThreads / 2) {
+    return invalidParameters("Failed input validation. Every arena needs at least 2 players (--arenas≤P/2)");
+  }
+
+  // Validate distributed mode
+  if (!mPeers.empty() && (mTryLockTargeting || mNodeId >= mPeers.size() || mNumThreads < mPeers.size())) {
+    return invalidParameters("Failed input validation. --node must index --peers, and every node needs a player");
   }
   return true;
 }
 
 
+/****************************************************************
+* invalidParameters:
+*   Records aError, and prints it unless silent. Always returns
+*   false.
+****************************************************************/
+bool Battleship::invalidParameters(const std::string &aError) {
+  mValidInputParameters = false;
+  mError = aError;
+  if (!mSilent) {
+    std::cout << UTL::COLOR_RED_BOLD << "ERROR" << UTL::COLOR_RESET << ": " << aError << "\n"
+              << "       For help, ./battleship --help\n";
+  }
+  return false;
+}
+
+
+/****************************************************************
+* initOption:
+*   Parses a single --name=value option.
+****************************************************************/
+bool Battleship::initOption(const std::string &option) {
+  const size_t pos = option.find('=');
+  const std::string name = option.substr(0, pos);
+  const std::string value = (pos == std::string::npos) ? "" : option.substr(pos + 1);
+
+  if (name.compare("--node") == 0 && UTL::isNumber(value, 0)) {
+    mNodeId = std::stoull(value);
+    return true;
+  }
+  else if (name.compare("--peers") == 0 && BattleshipNetwork::parsePeers(value, mPeers)) {
+    if (!BattleshipNetwork::isSupported()) {
+      std::cout << UTL::COLOR_RED_BOLD << "ERROR" << UTL::COLOR_RESET
+                << ": Distributed mode is not supported on this platform\n";
+      return false;
+    }
+    return true;
+  }
+  else if (name.compare("--net-batch") == 0 && UTL::isNumber(value, 1)) {
+    mNetworkBatchSize = std::stoull(value);
+    return true;
+  }
+  else if (name.compare("--workers") == 0 && UTL::isNumber(value, 1)) {
+    mNumWorkers = std::stoull(value);
+    return true;
+  }
+  else if (name.compare("--arenas") == 0 && UTL::isNumber(value, 1)) {
+    mNumArenas = std::stoull(value);
+    return true;
+  }
+  else if (name.compare("--huge-pages") == 0 && !value.empty()) {
+    for (size_t i = 0; i < BattleshipMemory::PAGES_COUNT; ++i) {
+      if (value.compare(BattleshipMemory::getName(static_cast<BattleshipMemory::PAGES>(i))) == 0) {
+        mPages = static_cast<BattleshipMemory::PAGES>(i);
+        return true;
+      }
+    }
+  }
+  else if (name.compare("--boards") == 0 && !value.empty()) {
+    for (size_t i = 0; i < BattleshipBoard::STORAGE_COUNT; ++i) {
+      if (value.compare(STORAGE_NAMES[i]) == 0) {
+        mBoards = static_cast<BattleshipBoard::STORAGE>(i);
+        return true;
+      }
+    }
+  }
+  else if (name.compare("--estimate") == 0 && pos == std::string::npos) {
+    mEstimate = true;
+    return true;
+  }
+  else if (name.compare("--counters") == 0 && pos == std::string::npos) {
+    mCountersEnabled = true;
+    return true;
+  }
+  else if (name.compare("--trace") == 0 && !value.empty()) {
+    mTraceFile = value;
+    return true;
+  }
+  else if (name.compare("--trace-sample") == 0 && UTL::isNumber(value, 1)) {
+    mTraceSample = std::stoull(value);
+    return true;
+  }
+  else if (name.compare("--attack-batch") == 0 && UTL::isNumber(value, 1)
+           && std::stoull(value) <= BattleshipPlayer::MAX_ATTACK_BATCH) {
+    mAttackBatch = std::stoull(value);
+    return true;
+  }
+  else if (name.compare("--targeting") == 0 && (value.compare("lock") == 0 || value.compare("trylock") == 0)) {
+    mTryLockTargeting = (value.compare("trylock") == 0);
+    return true;
+  }
+  else if (name.compare("--monitor") == 0 && UTL::isNumber(value, 1)) {
+    mMonitorInterval = std::stoull(value);
+    return true;
+  }
+  else if (name.compare("--view") == 0 && parsePlayerList(value, mViewPlayers)) {
+    return true;
+  }
+  else if (name.compare("--view-fps") == 0 && UTL::isNumber(value, 1) && std::stoull(value) <= MAX_VIEW_FPS) {
+    mViewFps = std::stoull(value);
+    return true;
+  }
+  else if (name.compare("--revive-odds") == 0 && UTL::isNumber(value, 0)) {
+    mReviveOdds = std::stoull(value);
+    return true;
+  }
+  else if (name.compare("--revive-below") == 0 && UTL::isNumber(value, 1) && std::stoull(value) <= 100) {
+    mReviveBelow = std::stoull(value);
+    return true;
+  }
+  else if (name.compare("--engine") == 0 && !value.empty()) {
+    for (size_t i = 0; i < ENGINE_COUNT; ++i) {
+      if (value.compare(ENGINE_NAMES[i]) == 0) {
+        mEngine = static_cast<ENGINE>(i);
+        return true;
+      }
+    }
+  }
+  else if (name.compare("--games") == 0 && UTL::isNumber(value, 1)) {
+    mGames = std::stoull(value);
+    return true;
+  }
+  else if (name.compare("--simd") == 0 && !value.empty()) {
+    if (value.compare("auto") == 0) {
+      mGamesWidth = BattleshipGames::detect();
+      return true;
+    }
+    for (size_t i = 0; i < BattleshipGames::WIDTH_COUNT; ++i) {
+      const BattleshipGames::WIDTH width = static_cast<BattleshipGames::WIDTH>(i);
+      if (value.compare(BattleshipGames::getName(width)) == 0) {
+        if (!BattleshipGames::isSupported(width)) {
+          return invalidParameters("--simd=" + value + " is not supported by this CPU");
+        }
+        mGamesWidth = width;
+        return true;
+      }
+    }
+  }
+  else if (name.compare("--seed") == 0 && UTL::isNumber(value, 1)) {
+    mSeed = std::stoull(value);
+    return true;
+  }
+  else if (name.compare("--sweep") == 0 && !value.empty()) {
+    mSweepFile = value;
+    return true;
+  }
+  else if (name.compare("--cores") == 0 && UTL::isNumber(value, 1)) {
+    mSweepCores = std::stoull(value);
+    return true;
+  }
+  else if (name.compare("--format") == 0 && (value.compare("csv") == 0 || value.compare("json") == 0)) {
+    mSweepJson = (value.compare("json") == 0);
+    return true;
+  }
+  else if (name.compare("--checkpoint") == 0 && !value.empty()) {
+    mCheckpointFile = value;
+    return true;
+  }
+  else if (name.compare("--checkpoint-interval") == 0 && UTL::isNumber(value, 1)) {
+    mCheckpointInterval = std::stoull(value);
+    return true;
+  }
+  else if (name.compare("--resume") == 0 && !value.empty()) {
+    mResumeFile = value;
+    return true;
+  }
+
+  return invalidParameters("Invalid option " + option);
+}
+
+
 /****************************************************************
 * createLogFile:
 *
@@ -187,138 +586,269 @@ void Battleship::createLogFile() {
 *
 ****************************************************************/
 void Battleship::initPlayers(size_t playerNum) {
-  // Create BattleshipPlayer
-  UTL_assert(mSize > 0 && mTargets <= mSize * mSize);
-  mPlayers[playerNum] = std::shared_ptr<BattleshipPlayer>(new BattleshipPlayer(playerNum, mSize, mTargets));
+  BattleshipTrace::Span span("initPlayers");
 
-  // Report done
-  TS::logAndPrint(mLogFile, mMtx[COUT], mMtx[LOG], "Player ", playerNum, " has been initialized.\n");
+  // Create BattleshipPlayer, or restore it from the checkpoint
+  UTL_assert(mSize > 0 && mTargets <= mSize * mSize);
+  if (mResume) {
+    const BattleshipCheckpoint::record_t &record = mResume->getRecord(playerNum);
+    mPlayers[playerNum] = std::unique_ptr<BattleshipPlayer>(new BattleshipPlayer(
+        playerNum, mSize, record.player, mResume->getInitialCells(playerNum), mResume->getCurrentCells(playerNum)));
+    mRngs[playerNum].setState(record.battleRngState);
+  }
+  else {
+    mPlayers[playerNum] = std::unique_ptr<BattleshipPlayer>(
+        new BattleshipPlayer(playerNum, mSize, mTargets, BattleshipRandom::hash(mSeed, 2 * playerNum), mBoards));
+    mRngs[playerNum].setState(BattleshipRandom::hash(mSeed, 2 * playerNum + 1));
+  }
 }
 
 
 /****************************************************************
 * battle:
-*
+*   Runs on every worker. Each worker takes turns for its players
+*   in round robin, and parks when none of them could attack.
 ****************************************************************/
-void Battleship::battle(size_t playerNum) {
-  mBegin->count_down_and_wait();
-  TS::logAndPrint(mLogFile, mMtx[COUT], mMtx[LOG], "Starting player ", playerNum, ".\n");
-
-  while (!mDone) {
-
-    std::unique_lock<std::mutex> playerLck(mPlayerMtx[playerNum]);
-    std::unique_lock<std::recursive_mutex> battleLck(mMtx[DATA_STRUCTURE_ACCESS]);
-    if (!mPlayers[playerNum]->isAlive()) {
-      // Check if done...
-      if (mDone.load(std::memory_order_relaxed)) {
-        TS::logAndPrint(mLogFile, mMtx[COUT], mMtx[LOG], "Player ", playerNum, " is exiting.\n");
-        battleLck.unlock();
-        return;
-      }
-      battleLck.unlock();
+void Battleship::battle(size_t worker) {
+  mBegin->arriveAndWait();
+  logAndPrint("Starting worker ", worker, ".\n");
 
-      // Wait for revive or done...
-      TS::logAndPrint(mLogFile, mMtx[COUT], mMtx[LOG], "Player ", playerNum, " is waiting.\n");
-      mCvs[playerNum].wait(playerLck, [this]() { return mDone.load(std::memory_order_relaxed); });
-      TS::logAndPrint(mLogFile, mMtx[COUT], mMtx[LOG], "Player ", playerNum, " has been notified.\n");
-      continue;
+  while (!mDone && mArenasRemaining.load() > 0) {
+    if (mCheckpointPending.load(std::memory_order_relaxed)) {
+      parkForCheckpoint(false);
     }
 
-    // Find target, and revive a target 10% of time
-    bool foundTarget = false;
-    size_t target;
+    bool attacked = false;
     {
-      std::random_device rd;
-      target = rd() % mNumThreads;
-      std::lock_guard<std::recursive_mutex> lck(mMtx[DATA_STRUCTURE_ACCESS]);
-      // Get a random opponent that is still alive.
-      for (size_t i = 0; i < mNumThreads; ++i) {
-        if (target != playerNum && mPlayers[target]->isAlive()) {
-          foundTarget = true;
-          break;
-        }
-        else if (target == mNumThreads - 1) {
-          target = 0;
-        }
-        else {
-          target++;
+      // A turn never allocates, see BattleshipAllocations
+      BattleshipAllocations::Forbid forbid;
+      attacked = battleRevived(worker);
+      for (size_t playerNum = mLocalBegin + worker; playerNum < mLocalEnd && !mDone; playerNum += mNumWorkers) {
+        BattleshipTrace::Span span("battleTurn");
+        if (mNetwork ? battleDistributedTurn(playerNum) : battleTurn(playerNum)) {
+          attacked = true;
         }
       }
+    }
 
-      if (foundTarget) {
-        size_t targetsAlive = 0;
+    // Wait for a revive or done, or retry after 1 ms
+    if (!attacked && !mDone && mArenasRemaining.load() > 0) {
+      BattleshipTrace::Span span("park");
+      std::unique_lock<std::mutex> workerLck(mWorkerMtx[worker]);
+      mCvs[worker].wait_for(workerLck, std::chrono::milliseconds(1), [this, worker]() {
+        return mRevived[worker].pending.load() || mDone || mArenasRemaining.load() == 0;
+      });
+    }
+  }
 
-        // Find number of players that are alive
-        for (auto player : mPlayers) {
-          if (player->isAlive()) {
-            targetsAlive++;
-          }
-        }
+  if (!mCheckpointFile.empty()) {
+    parkForCheckpoint(true);
+  }
+  logAndPrint("Worker ", worker, " is exiting.\n");
+}
 
-        // 10% of the time attempt to revive a target if over half the targets are dead, but at least 2 are alive
-        if ((targetsAlive) > 2 && (targetsAlive < (mNumThreads / 2))) {
-          if ((rd() % 10) == 0) {
-            size_t reviveTarget = rd() % mNumThreads;
-            // Find random !isAlive thread and revive.
-            for (size_t i = 0; i < mNumThreads; ++i) {
-              if (reviveTarget != playerNum && !mPlayers[reviveTarget]->isAlive()) {
-                TS::logAndPrint(mLogFile, mMtx[COUT], mMtx[LOG], "Player ", reviveTarget, " is being revived.\n");
-                mPlayers[playerNum]->revive();
-                TS::logAndPrint(mLogFile, mMtx[COUT], mMtx[LOG], "Player ", playerNum, " has been revived.\n");
-                mCvs[reviveTarget].notify_all();
-                break;
-              }
-              else if (reviveTarget == mNumThreads - 1) {
-                reviveTarget = 0;
-              }
-              else {
-                reviveTarget++;
-              }
-            }
-          }
-        }
-      }
+
+/****************************************************************
+* battleTurn:
+*   One attack by playerNum. Opponents, revives and the winner all
+*   come from the player's arena, under the arena's lock. Returns
+*   false if the player could not attack.
+****************************************************************/
+bool Battleship::battleTurn(size_t playerNum) {
+  // Eliminated in an earlier round
+  if (mArenaOfPlayer[playerNum] == NO_ARENA) {
+    return false;
+  }
+  arena_t &arena = *mArenas[mArenaOfPlayer[playerNum]];
+
+  std::unique_lock<std::mutex> playerLck(mPlayerMtx[playerNum]);
+  std::unique_lock<std::recursive_mutex> battleLck(arena.mtx, std::defer_lock);
+  {
+    BattleshipTrace::Span span("arenaLock");
+    battleLck.lock();
+  }
+  if (arena.done || !mPlayers[playerNum]->isAlive()) {
+    return false;
+  }
+
+  // Get a random opponent that is still alive, preferably one that was not recently found locked
+  const size_t target
+      = pickOpponent(arena, playerNum, mTryLockTargeting ? &mTargeting[workerOfPlayer(playerNum)] : nullptr);
+
+  // If unable to find target, you must be last one alive in the arena.
+  if (target == NO_PLAYER) {
+    if (winArena(arena, playerNum)) {
+      battleLck.unlock();
+      announceArenaWinner(playerNum);
     }
+    return false;
+  }
 
-    // If unable to find target, you must be last one alive.
-    if (!foundTarget) {
-      std::unique_lock<std::recursive_mutex> lck(mMtx[DATA_STRUCTURE_ACCESS]);
-      // Verify no targets are alive
-      size_t targetsAlive = 0;
-      for (auto player : mPlayers) {
-        if (player->isAlive()) {
-          targetsAlive++;
-        }
-      }
+  const size_t revived = reviveOpponent(arena, playerNum);
+  if (revived != NO_PLAYER) {
+    handOffRevived(revived);
+  }
+  recordReviveLatency(playerNum);
 
-      if (targetsAlive > 1) {
-        TS::logAndPrint(mLogFile, mMtx[COUT], mMtx[LOG], "ERROR: At exit but multiple players are still alive...\n");
-        continue;
-      }
+  // Attack outside of the arena lock, backing off from locked opponents
+  if (mTryLockTargeting) {
+    battleLck.unlock();
+    tryLockAttack(playerNum, target, arena);
+    return true;
+  }
 
-      mDone.store(true, std::memory_order_relaxed);
-      lck.unlock();
-      for (size_t i = 0; i < mNumThreads; i++) {
-        mCvs[i].notify_all();
+  attackOpponent(playerNum, target);
+  return true;
+}
+
+
+/****************************************************************
+* reviveOpponent:
+*   Revives a dead player in the arena when shouldRevive says so.
+*   Caller must hold the arena lock. Returns the player chosen, or
+*   NO_PLAYER.
+****************************************************************/
+size_t Battleship::reviveOpponent(const arena_t &arena, size_t playerNum) {
+  const std::vector<size_t> &players = arena.players;
+  BattleshipRandom &rng = mRngs[playerNum];
+  if (mReviveOdds == 0) {
+    return NO_PLAYER;
+  }
+
+  // Find number of players that are alive
+  size_t targetsAlive = 0;
+  for (size_t player : players) {
+    if (mPlayers[player]->isAlive()) {
+      targetsAlive++;
+    }
+  }
+
+  if (shouldRevive(targetsAlive, players.size(), rng)) {
+    size_t reviveIndex = rng() % players.size();
+    // Find random !isAlive thread and revive.
+    for (size_t i = 0; i < players.size(); ++i) {
+      const size_t reviveTarget = players[reviveIndex];
+      if (reviveTarget != playerNum && !mPlayers[reviveTarget]->isAlive()) {
+        revivePlayer(reviveTarget);
+        logAndPrint("Player ", reviveTarget, " has been revived by player ", playerNum, ".\n");
+        emitEvent(EVENT_PLAYER_REVIVED, reviveTarget, playerNum);
+        return reviveTarget;
       }
-      TS::logAndPrintAlways(mLogFile, mMtx[COUT], mMtx[LOG], "Player ", playerNum, " just won the battle.\n");
-      mWinner = playerNum;
-      return;
+      reviveIndex = (reviveIndex + 1) % players.size();
+    }
+  }
+  return NO_PLAYER;
+}
+
+
+/****************************************************************
+* winArena:
+*   Called when playerNum found no opponent alive. Caller must hold
+*   the arena lock. Returns false if another player is somehow
+*   still alive.
+****************************************************************/
+bool Battleship::winArena(arena_t &arena, size_t playerNum) {
+  // Verify no targets are alive
+  size_t targetsAlive = 0;
+  for (size_t player : arena.players) {
+    if (mPlayers[player]->isAlive()) {
+      targetsAlive++;
+    }
+  }
+
+  if (targetsAlive > 1) {
+    logAndPrint("ERROR: At exit but multiple players are still alive...\n");
+    return false;
+  }
+
+  arena.done = true;
+  arena.winner = playerNum;
+  return true;
+}
+
+
+void Battleship::announceArenaWinner(size_t playerNum) {
+  // The only arena left is the final
+  if (mArenas.size() == 1) {
+    logAndPrintAlways("Player ", playerNum, " just won the battle.\n");
+    mWinner = playerNum;
+    emitEvent(EVENT_BATTLE_WON, playerNum, playerNum);
+    mDone.store(true);
+  }
+  else {
+    logAndPrint("Player ", playerNum, " just won arena ", mArenaOfPlayer[playerNum], ".\n");
+    emitEvent(EVENT_ARENA_WON, playerNum, mArenaOfPlayer[playerNum]);
+  }
+
+  if (--mArenasRemaining == 0) {
+    for (auto &cv : mCvs) {
+      cv.notify_all();
+    }
+  }
+}
+
+
+/****************************************************************
+* attackOpponent:
+*   A single shot, or a salvo of mAttackBatch shots, at target.
+****************************************************************/
+void Battleship::attackOpponent(size_t playerNum, size_t target) {
+  bool sunk = false;
+
+  // Fire a salvo, the shots are chosen before any of them land
+  if (mAttackBatch > 1) {
+    const size_t shots = mPlayers[playerNum]->launchAttacks(*mPlayers[target], mAttackBatch, &sunk);
+    logAndPrint("Player ", playerNum, " fired ", shots, " shots at player ", target, ".\n");
+    if (sunk) {
+      emitEvent(EVENT_PLAYER_SUNK, target, playerNum);
     }
+    return;
+  }
 
-    // get coordinate to attack
-    BattleshipBoard::coordinate_t coordToAttack = mPlayers[target]->getTargetCoordinates();
+  // get coordinate to attack
+  BattleshipBoard::coordinate_t coordToAttack = mPlayers[target]->getTargetCoordinates();
 
-    if (coordToAttack.getRow() != coordToAttack.invalid() && coordToAttack.getCol() != coordToAttack.invalid()) {
-      TS::logAndPrint(mLogFile, mMtx[COUT], mMtx[LOG], "Player ", playerNum, " is attacking player ",
-                      mPlayers[target]->getPlayerNum(), " at location (", coordToAttack.getRow(), ",",
-                      coordToAttack.getCol(), ").\n");
-      mPlayers[playerNum]->launchAttack(mPlayers[target], coordToAttack);
+  if (coordToAttack.getRow() != coordToAttack.invalid() && coordToAttack.getCol() != coordToAttack.invalid()) {
+    logAndPrint("Player ", playerNum, " is attacking player ", mPlayers[target]->getPlayerNum(), " at location (",
+                coordToAttack.getRow(), ",", coordToAttack.getCol(), ").\n");
+    mPlayers[playerNum]->launchAttack(*mPlayers[target], coordToAttack, &sunk);
+    if (sunk) {
+      emitEvent(EVENT_PLAYER_SUNK, target, playerNum);
     }
   }
 }
 
 
+size_t Battleship::workerOfPlayer(size_t playerNum) const {
+  return (playerNum - mLocalBegin) % mNumWorkers;
+}
+
+
+/****************************************************************
+* describePages:
+*   What BattleshipMemory actually got from the kernel, read once
+*   the players exist so their pages have been touched.
+****************************************************************/
+std::string Battleship::describePages() const {
+  const BattleshipMemory::usage_t usage = BattleshipMemory::getUsage();
+  const size_t MiB = 1 << 20;
+  return std::string(BattleshipMemory::getName(mPages)) + ", " + std::to_string(usage.usedBytes / MiB) + " of "
+         + std::to_string(usage.reservedBytes / MiB) + " MiB used in " + std::to_string(usage.chunks) + " chunks, "
+         + std::to_string(usage.explicitHugeBytes / MiB) + " MiB explicit and "
+         + std::to_string(usage.transparentHugeBytes / MiB) + " MiB transparent huge pages";
+}
+
+
+const char *Battleship::getName(ENGINE aEngine) {
+  return aEngine < ENGINE_COUNT ? ENGINE_NAMES[aEngine] : "unknown";
+}
+
+
+const char *Battleship::getName(BattleshipBoard::STORAGE aBoards) {
+  return aBoards < BattleshipBoard::STORAGE_COUNT ? STORAGE_NAMES[aBoards] : "unknown";
+}
+
+
 /****************************************************************
 * generateReport:
 *
@@ -328,15 +858,45 @@ void Battleship::generateReport() {
   std::lock_guard<std::recursive_mutex> lckCout(mMtx[COUT], std::adopt_lock);
   std::lock_guard<std::recursive_mutex> lckLog(mMtx[LOG], std::adopt_lock);
 
+  // Every local player's section, plus room for the rest
+  mReport.reserve(mReport.size() + BattleshipPlayer::REPORT_BYTES * (mLocalEnd - mLocalBegin + 16));
+
   mReport += "Battle Details:\n";
   mReport += "  P = " + std::to_string(mNumThreads) + "\n";
   mReport += "  M = " + std::to_string(mTargets) + "\n";
   mReport += "  N = " + std::to_string(mSize) + "\n";
+  mReport += "  Seed = " + std::to_string(mSeed) + "\n";
+  mReport += std::string("  Engine = ") + ENGINE_NAMES[mEngine] + "\n";
+  if (mEngine == ENGINE_LOCKSTEP) {
+    mReport += "  Lockstep Rounds = " + std::to_string(mLockstepRounds) + "\n";
+  }
+  mReport += "  Workers = " + std::to_string(mNumWorkers) + "\n";
+  mReport += "  Attack Batch = " + std::to_string(mAttackBatch) + "\n";
+  mReport += std::string("  Targeting = ") + (mTryLockTargeting ? "trylock" : "lock") + "\n";
+  if (mReviveOdds == 0) {
+    mReport += "  Revives = off\n";
+  }
+  else if (mReviveOdds != 10 || mReviveBelow != 50) {
+    mReport += "  Revives = 1 in " + std::to_string(mReviveOdds) + " turns, below " + std::to_string(mReviveBelow)
+               + "% alive\n";
+  }
+  if (mPages != BattleshipMemory::PAGES_HEAP) {
+    mReport += "  Huge Pages = " + mPagesObtained + "\n";
+  }
+  if (mBoards != BattleshipBoard::STORAGE_EAGER) {
+    mReport += std::string("  Boards = ") + STORAGE_NAMES[mBoards] + "\n";
+  }
+  if (!mResumeFile.empty()) {
+    mReport += "  Resumed from " + mResumeFile + "\n";
+  }
 
   // Store boards in ss if conditions below are true
   if (mNumThreads == 2 && mSize <= 40) {
     mReport += "Boards:\n";
     for (auto &player : mPlayers) {
+      if (!player) {
+        continue;
+      }
       mReport += player->printInitialBoard();
       mReport += player->printCurrentBoard();
     }
@@ -352,16 +912,20 @@ void Battleship::generateReport() {
   size_t attacksLaunchedSecondaryHits = 0;
   size_t attacksLaunchedSecondaryMisses = 0;
 
-  // Generate report data and store in ss
+  // Generate report data and store in ss, remote players are reported by their own node
   for (auto &player : mPlayers) {
-    mReport += player->generateReport();
-    remainingTargets += player->getRemainingTargets();
-    timesRevived += player->getTimesRevived();
-    attacksReceived += player->getAttacksReceived();
-    attacksLaunchedInitialHits += player->getAttacksLaunchedInitialHits();
-    attacksLaunchedInitialMisses += player->getAttacksLaunchedInitialMisses();
-    attacksLaunchedSecondaryHits += player->getAttacksLaunchedSecondaryHits();
-    attacksLaunchedSecondaryMisses += player->getAttacksLaunchedSecondaryMisses();
+    if (!player) {
+      continue;
+    }
+    player->appendReport(mReport);
+    const BattleshipPlayer::stats_t stats = player->snapshot();
+    remainingTargets += stats.remainingTargets;
+    timesRevived += stats.timesRevived;
+    attacksReceived += stats.attacksReceived;
+    attacksLaunchedInitialHits += stats.attacksLaunchedInitialHits;
+    attacksLaunchedInitialMisses += stats.attacksLaunchedInitialMisses;
+    attacksLaunchedSecondaryHits += stats.attacksLaunchedSecondaryHits;
+    attacksLaunchedSecondaryMisses += stats.attacksLaunchedSecondaryMisses;
   }
   const size_t attacksLaunched = attacksLaunchedInitialHits + attacksLaunchedInitialMisses
                                  + attacksLaunchedSecondaryHits + attacksLaunchedSecondaryMisses;
@@ -389,6 +953,29 @@ void Battleship::generateReport() {
   mReport += std::to_string(
       std::chrono::duration_cast<std::chrono::duration<double>>(mBattleEndTimePoint - mBattleStartTimePoint).count());
   mReport += " seconds.\n";
+
+  if (mRevives.load() > 0) {
+    generateReviveReport();
+  }
+  if (mNumArenas > 1) {
+    generateTournamentReport();
+  }
+  if (mTryLockTargeting) {
+    generateTargetingReport();
+  }
+  if (mMonitorSnapshots > 0) {
+    generateMonitorReport();
+  }
+  if (mViewFrames > 0) {
+    generateViewReport();
+  }
+  generateMemoryReport();
+  if (mCountersEnabled) {
+    generateCountersReport();
+  }
+  if (mNetwork) {
+    generateNetworkReport();
+  }
 }
 
 
@@ -402,56 +989,146 @@ void Battleship::run() {
     return;
   }
 
+  // Each game of the sweep is a Battleship of its own
+  if (mSweep) {
+    runSweep();
+    return;
+  }
+
+  // Dry run, nothing is allocated
+  if (mEstimate) {
+    printEstimate();
+    return;
+  }
+  sampleResources(mStartResources);
+
+  // Many small games instead of one battle
+  if (mGames > 0) {
+    runGames();
+    return;
+  }
+
+  if (!mTraceFile.empty()) {
+    BattleshipTrace::start(mTraceSample);
+    BattleshipTrace::setThreadName("Main");
+  }
+
+  // Start the workers once, they are reused for every phase. A sweep may hand over the workers of an earlier game.
+  if (!mPool || mPool->size() != mNumWorkers) {
+    mPool = std::unique_ptr<BattleshipWorkerPool>(new BattleshipWorkerPool(mNumWorkers));
+  }
+  if (!mTraceFile.empty()) {
+    mPool->runOnEach([](size_t worker) { BattleshipTrace::setThreadName("Worker " + std::to_string(worker)); });
+  }
+  if (mCountersEnabled) {
+    openCounters();
+  }
+
   // Init players
-  TS::logAndPrintAlways(mLogFile, mMtx[COUT], mMtx[LOG], "Initializing Players...\n");
+  logAndPrintAlways("Initializing Players...\n");
   mInitStartTimePoint = std::chrono::high_resolution_clock::now();
-  for (size_t i = 0; i < mNumThreads; ++i) {
-    //TS::logAndPrint(mLogFile, mMtx[COUT], mMtx[LOG], "Launching thread ", i, " to initialize player.\n");
-    mThreads[i] = std::async(std::launch::async, &Battleship::initPlayers, this, i);
+  startCounters();
+  const size_t localPlayers = mLocalEnd - mLocalBegin;
+  mPool->parallelFor(localPlayers, localPlayers / (mNumWorkers * 8),
+                     [this](size_t i) { initPlayers(mLocalBegin + i); });
+  stopCounters(mInitSamples);
+  mInitEndTimePoint = std::chrono::high_resolution_clock::now();
+  mResume.reset();
+  sampleResources(mInitResources);
+  logAndPrintAlways("Finished Initializing Players.\n");
+  emitEvent(EVENT_PLAYERS_READY, mLocalEnd - mLocalBegin, 0);
+  if (mPages != BattleshipMemory::PAGES_HEAP) {
+    mPagesObtained = describePages();
+    logAndPrintAlways("Huge Pages: ", mPagesObtained, "\n");
   }
 
-  // Wait init to finish
-  for (auto &thread : mThreads) {
-    thread.wait();
+  // Connect to the other nodes once our players exist
+  if (mNetwork && !startNetwork()) {
+    return;
   }
-  mInitEndTimePoint = std::chrono::high_resolution_clock::now();
-  TS::logAndPrintAlways(mLogFile, mMtx[COUT], mMtx[LOG], "Finished Initializing Players.\n");
 
   // launch battle
-  TS::logAndPrintAlways(mLogFile, mMtx[COUT], mMtx[LOG], "Starting Battle...\n");
+  logAndPrintAlways("Starting Battle...\n");
+  if (!mCheckpointFile.empty()) {
+    mCheckpointThread = std::async(std::launch::async, &Battleship::checkpointLoop, this);
+  }
+  if (mMonitorInterval > 0) {
+    mMonitorThread = std::async(std::launch::async, &Battleship::monitorLoop, this);
+  }
+  if (!mViewPlayers.empty()) {
+    startView();
+  }
   mBattleStartTimePoint = std::chrono::high_resolution_clock::now();
-  for (size_t i = 0; i < mNumThreads; ++i) {
-    //TS::logAndPrint(mLogFile, mMtx[COUT], mMtx[LOG], "Launching thread ", i, " to go.\n");
-    mThreads[i] = std::async(std::launch::async, &Battleship::battle, this, i);
+  startCounters();
+  std::vector<size_t> contenders(localPlayers);
+  std::iota(contenders.begin(), contenders.end(), mLocalBegin);
+  do {
+    startRound(contenders);
+    if (mEngine == ENGINE_SEQUENTIAL) {
+      mPool->runOnEach([this](size_t) { battleSequential(); });
+    }
+    else if (mEngine == ENGINE_LOCKSTEP) {
+      battleLockstep();
+    }
+    else {
+      mPool->runOnEach([this](size_t worker) { battle(worker); });
+    }
+    contenders = finishRound();
+  } while (!mDone && contenders.size() > 1);
+  stopCounters(mBattleSamples);
+  if (mCheckpointThread.valid()) {
+    mCheckpointCv.notify_all();
+    mCheckpointThread.wait();
   }
-
-  // Wait for battle to end
-  // #ifdef NDEBUG
-  //   TS::print(mMtx[COUT], "Please wait");
-  //   for (auto &thread : mThreads) {
-  //     while (thread.wait_for(std::chrono::milliseconds(100)) == std::future_status::timeout) {
-  //       TS::print(mMtx[COUT], ".");
-  //     }
-  //   }
-  // #else
-  for (auto &thread : mThreads) {
-    thread.wait();
+  if (mMonitorThread.valid()) {
+    {
+      std::lock_guard<std::mutex> lck(mMonitorMtx);
+      mMonitorDone = true;
+    }
+    mMonitorCv.notify_all();
+    mMonitorThread.wait();
+  }
+  if (mViewThread.valid()) {
+    stopView();
   }
-  // #endif
 
   mBattleEndTimePoint = std::chrono::high_resolution_clock::now();
-  TS::logAndPrintAlways(mLogFile, mMtx[COUT], mMtx[LOG], "Completed Battle.\n\n");
+  sampleResources(mBattleResources);
+  if (mNetwork) {
+    mNetwork->stop();
+  }
+  logAndPrintAlways("Completed Battle.\n\n");
 
   // Generate report
-  TS::logAndPrintAlways(mLogFile, mMtx[COUT], mMtx[LOG], "Generating Report: ");
-  generateReport();
-  TS::logAndPrintAlways(mLogFile, mMtx[COUT], mMtx[LOG], "Done\n\n");
+  logAndPrintAlways("Generating Report: ");
+  {
+    BattleshipTrace::Span span("generateReport");
+    generateReport();
+  }
+  sampleResources(mReportResources);
+  logAndPrintAlways("Done (Report Phase: ", describeResources(mBattleResources, mReportResources), ")\n\n");
+
+  // Every worker is idle, so the trace buffers can be read
+  if (!mTraceFile.empty()) {
+    BattleshipTrace::stop();
+    if (BattleshipTrace::write(mTraceFile)) {
+      logAndPrintAlways("Wrote ", BattleshipTrace::getEventCount(), " trace events to ", mTraceFile, " (",
+                        BattleshipTrace::getDroppedCount(), " dropped).\n\n");
+    }
+    else {
+      logAndPrintAlways(UTL::COLOR_PURPLE_BOLD, "Warning", UTL::COLOR_RESET, ": Unable to write trace ", mTraceFile,
+                        "\n\n");
+    }
+  }
 
 #ifdef ENABLE_LOGGING
   // Always log boards to file
   if (mLogFile.is_open() && !(mNumThreads == 2 && mSize <= 40)) {
     TS::log(mLogFile, mMtx[LOG], "Boards:\n");
     for (auto &player : mPlayers) {
+      if (!player) {
+        continue;
+      }
       TS::log(mLogFile, mMtx[LOG], player->printInitialBoard());
       TS::log(mLogFile, mMtx[LOG], player->printCurrentBoard());
     }
@@ -459,5 +1136,5 @@ void Battleship::run() {
 #endif
 
   // Output report
-  TS::logAndPrintAlways(mLogFile, mMtx[COUT], mMtx[LOG], mReport);
+  logAndPrintAlways(mReport);
 }
@@ -3,7 +3,7 @@
 * @Author:   Ben Sokol
 * @Email:    ben@bensokol.com
 * @Created:  February 13th, 2019 [10:58am]
-* @Modified: February 22nd, 2019 [11:29pm]
+* @Modified: October 19th, 2026 [1:45am]
 * @Version:  1.0.0
 *
 * Copyright (C) 2019 by Ben Sokol. All Rights Reserved.
@@ -12,39 +12,233 @@
 #ifndef BATTLESHIP_HPP
 #define BATTLESHIP_HPP
 
-#include <atomic>   // std::atomic
-#include <cstdlib>  // size_t
-#include <fstream>  // std::ofstream
-#include <future>   // std::future
-#include <memory>   // std::unique_ptr
-#include <mutex>    // std::recursive_mutex
-#include <string>   // std::string
-#include <vector>   // std::vector
+#include <atomic>              // std::atomic
+#include <chrono>              // std::chrono::high_resolution_clock
+#include <condition_variable>  // std::condition_variable
+#include <cstdint>             // uint64_t
+#include <cstdlib>             // size_t
+#include <fstream>             // std::ofstream
+#include <functional>          // std::function
+#include <future>              // std::future
+#include <memory>              // std::unique_ptr
+#include <mutex>               // std::recursive_mutex
+#include <string>              // std::string
+#include <utility>             // std::forward
+#include <vector>              // std::vector
 
+#include "BattleshipAllocations.hpp"
+#include "BattleshipBarrier.hpp"
+#include "BattleshipCheckpoint.hpp"
+#include "BattleshipCounters.hpp"
+#include "BattleshipGames.hpp"
+#include "BattleshipMemory.hpp"
+#include "BattleshipNetwork.hpp"
 #include "BattleshipPlayer.hpp"
-#include "TS_latch.hpp"
+#include "BattleshipRandom.hpp"
+#include "BattleshipSweep.hpp"
+#include "BattleshipView.hpp"
+#include "BattleshipWorkerPool.hpp"
 #include "TS_log.hpp"
+#include "TS_logAndPrint.hpp"
 #include "TS_print.hpp"
 
 
 class Battleship {
 public:
+  // How the battle phase runs, --engine
+  enum ENGINE {
+    ENGINE_THREADED,    // free-running workers that lock the players they attack
+    ENGINE_SEQUENTIAL,  // an event loop on one worker, see Battleship_Sequential.cpp
+    ENGINE_LOCKSTEP,    // synchronous rounds on every worker, see Battleship_Lockstep.cpp
+    ENGINE_COUNT
+  };
+
+  // A game built without a command line, see Battleship_Engine.cpp
+  struct config_t {
+    size_t players = 2;
+    size_t size = 10;
+    size_t targets = 10;
+    size_t workers = 0;  // one per core
+    uint64_t seed = 0;   // random
+    size_t arenas = 1;
+    size_t attackBatch = 1;
+    bool tryLockTargeting = false;
+    ENGINE engine = ENGINE_THREADED;
+    uint64_t games = 0;  // > 0 plays that many two player games instead of one battle, see Battleship_Games.cpp
+    BattleshipMemory::PAGES pages = BattleshipMemory::PAGES_HEAP;
+    BattleshipBoard::STORAGE boards = BattleshipBoard::STORAGE_EAGER;
+    size_t reviveOdds = 10;   // a turn revives a player one time in reviveOdds, 0 never
+    size_t reviveBelow = 50;  // only while fewer than this percent of the arena is alive
+    bool silent = true;  // nothing is written to stdout, errors are read with getError
+  };
+
+  enum EVENT {
+    EVENT_PLAYERS_READY,   // player is the number of players, every one has placed its targets
+    EVENT_PLAYER_SUNK,     // player lost its last target to other
+    EVENT_PLAYER_REVIVED,  // player was revived by other
+    EVENT_ARENA_WON,       // player won arena other, in tournament mode
+    EVENT_BATTLE_WON,      // player won the battle
+    EVENT_COUNT
+  };
+
+  struct event_t {
+    EVENT type;
+    size_t player;
+    size_t other;
+  };
+
+  // Called on the thread that caused the event, so it must be thread-safe and should return quickly
+  typedef std::function<void(const event_t &)> callback_t;
+
   Battleship(const int argc, const char *argv[]);
+  explicit Battleship(const config_t &aConfig);
   ~Battleship();
 
   void printVersion() const;
   static void printHelp();
   void run();
 
+  // Must be called before run
+  void addCallback(callback_t aCallback);
+
+  bool isValid() const;
+  const std::string &getError() const;
+  size_t getWinner() const;
+  const std::string &getReport() const;
+
 private:
+  struct arena_t;
+
+  Battleship();
+  void initEngine();
   bool initParameters(const int &argc, const char *argv[]);
+  bool validateParameters();
+  bool invalidParameters(const std::string &aError);
+  bool initOption(const std::string &option);
   void initPlayers(size_t playerNum);
-  void battle(size_t playerNum);
+  void battle(size_t worker);
+  bool battleTurn(size_t playerNum);
+  size_t reviveOpponent(const arena_t &arena, size_t playerNum);
+  bool winArena(arena_t &arena, size_t playerNum);
+  void announceArenaWinner(size_t playerNum);
+  void attackOpponent(size_t playerNum, size_t target);
+  size_t workerOfPlayer(size_t playerNum) const;
+  static const char *getName(ENGINE aEngine);
+  static const char *getName(BattleshipBoard::STORAGE aBoards);
   void generateReport();
+  std::string describePages() const;
+
+  // Try-lock targeting, see Battleship_Targeting.cpp
+  struct targeting_t;
+  size_t pickOpponent(const arena_t &arena, size_t playerNum, const targeting_t *aAvoid);
+  void tryLockAttack(size_t playerNum, size_t target, arena_t &arena);
+  void generateTargetingReport();
+
+  // Sequential engine, see Battleship_Sequential.cpp
+  void battleSequential();
+
+  // Lockstep engine, see Battleship_Lockstep.cpp
+  void battleLockstep();
+  void pickLockstep(size_t playerNum);
+  void applyLockstep(size_t target);
+  void settleLockstep();
+
+  // Many small games, see Battleship_Games.cpp
+  void runGames();
+  void generateGamesReport();
+
+  // Distributed mode, see Battleship_Distributed.cpp
+  bool startNetwork();
+  bool battleDistributedTurn(size_t playerNum);
+  void handleMessage(size_t node, const BattleshipNetwork::message_t &message);
+  void syncStatus(size_t playerNum);
+  void setStatus(size_t playerNum, bool alive);
+  void finishBattle(size_t winner);
+  bool isLocalPlayer(size_t playerNum) const;
+  size_t nodeOfPlayer(size_t playerNum) const;
+  void generateNetworkReport();
+
+  // Tournament mode, see Battleship_Tournament.cpp
+  void startRound(const std::vector<size_t> &contenders);
+  std::vector<size_t> finishRound();
+  void generateTournamentReport();
+
+  // Revives, see Battleship_Revive.cpp
+  void revivePlayer(size_t playerNum);
+  void handOffRevived(size_t playerNum);
+  bool battleRevived(size_t worker);
+  void settleReviveLatency(size_t playerNum);
+  bool shouldRevive(size_t aliveCount, size_t playerCount, BattleshipRandom &rng) const;
+  void generateReviveReport();
+  // Called before each attack, only leaves the fast path on the first attack after a revive
+  void recordReviveLatency(size_t playerNum) {
+    if (mRevivedAt[playerNum].load(std::memory_order_relaxed) != 0) {
+      settleReviveLatency(playerNum);
+    }
+  }
+
+  // Parameter sweeps, see Battleship_Sweep.cpp
+  bool loadSweep();
+  bool initSweepGame(const BattleshipSweep::point_t &aPoint, size_t aRepeat);
+  void runSweep();
+  std::string describeSweepRun(size_t aRun, const Battleship &aGame) const;
+
+  // Live stats, see Battleship_Monitor.cpp
+  void monitorLoop();
+  void generateMonitorReport();
+
+  // Live view, see Battleship_View.cpp
+  void startView();
+  void stopView();
+  void viewLoop();
+  void generateViewReport();
+
+  // Memory accounting, see Battleship_Memory.cpp
+  struct memoryUsage_t;
+  struct resources_t;
+  size_t workerCount(size_t localPlayers) const;
+  memoryUsage_t accountMemory(bool aEstimate);
+  void sampleResources(resources_t &resources);
+  std::string describeResources(const resources_t &aBefore, const resources_t &aAfter) const;
+  void generateMemoryReport();
+  void printEstimate();
+
+  // Hardware counters, see Battleship_Counters.cpp
+  void openCounters();
+  void startCounters();
+  void stopCounters(std::vector<BattleshipCounters::sample_t> &samples);
+  void generateCountersReport();
+
+  // Checkpoints, see Battleship_Checkpoint.cpp
+  bool loadCheckpoint();
+  void checkpointLoop();
+  void parkForCheckpoint(bool aLeaving);
+  void captureCheckpoint(BattleshipCheckpoint &checkpoint);
+  void writeCheckpoint(BattleshipCheckpoint &checkpoint);
 #ifdef ENABLE_LOGGING
   void createLogFile();
 #endif
 
+  // Every message goes through these, so silent mode writes nothing
+  template <typename... Args>
+  void logAndPrint(Args &&... args) {
+    if (!mSilent) {
+      TS::logAndPrint(mLogFile, mMtx[COUT], mMtx[LOG], std::forward<Args>(args)...);
+    }
+  }
+  template <typename... Args>
+  void logAndPrintAlways(Args &&... args) {
+    if (!mSilent) {
+      TS::logAndPrintAlways(mLogFile, mMtx[COUT], mMtx[LOG], std::forward<Args>(args)...);
+    }
+  }
+
+  // Callbacks, registered before run and only read during it, so emitting takes no lock
+  void emitEvent(EVENT aType, size_t aPlayer, size_t aOther);
+  std::vector<callback_t> mCallbacks;
+  bool mSilent;
+  std::string mError;
+
   // logging
   std::ofstream mLogFile;
 
@@ -53,12 +247,13 @@ private:
   const size_t mVersionMinor;
   const size_t mVersionBug;
 
-  // Players
-  std::vector<std::shared_ptr<BattleshipPlayer>> mPlayers;
-  std::vector<bool> mRevivePlayer;
+  // Players, owned here. The battle phase only passes references and indices, the vector is never resized after
+  // construction, so a reference stays valid and no reference count is touched on every attack.
+  std::vector<std::unique_ptr<BattleshipPlayer>> mPlayers;
 
-  // Threads/Futures
-  std::vector<std::future<void>> mThreads;
+  // Workers, shared by the init and battle phases
+  std::unique_ptr<BattleshipWorkerPool> mPool;
+  size_t mNumWorkers;
 
   // Atomic Variables
   std::atomic<bool> mDone;
@@ -67,16 +262,214 @@ private:
   enum MTX {
     COUT,  // Used for std::cout
     LOG,   // Used for logging to file
-    DATA_STRUCTURE_ACCESS,
     MTX_COUNT
   };
   std::vector<std::recursive_mutex> mMtx;
   std::vector<std::mutex> mPlayerMtx;
+  std::vector<std::mutex> mWorkerMtx;
 
-  // condition_variable
-  std::unique_ptr<TS::Latch> mBegin;
+  // condition_variable, mCvs[w] wakes worker w
+  std::unique_ptr<BattleshipBarrier> mBegin;
   std::vector<std::condition_variable> mCvs;
 
+  // Revives. A revived player is handed to its worker, which runs it ahead of its round robin. mRevivedAt[p] is
+  // when p was revived, in nanoseconds into the battle plus one, until its next attack, otherwise 0. The rules are
+  // --revive-odds and --revive-below.
+  struct revived_t {
+    std::vector<size_t> players;  // guarded by the worker's mWorkerMtx
+    std::vector<size_t> taken;    // only used by the worker
+    std::atomic<bool> pending{ false };
+  };
+  std::vector<revived_t> mRevived;
+  std::vector<std::atomic<uint64_t>> mRevivedAt;
+  std::atomic<uint64_t> mRevives;
+  std::atomic<uint64_t> mReviveLatencies;
+  std::atomic<uint64_t> mReviveLatencyNanoseconds;
+  std::atomic<uint64_t> mReviveLatencyMax;
+  size_t mReviveOdds;
+  size_t mReviveBelow;
+
+  // Distributed mode, players [mLocalBegin, mLocalEnd) live on this node
+  std::unique_ptr<BattleshipNetwork> mNetwork;
+  std::vector<std::string> mPeers;
+  size_t mNodeId;
+  size_t mNetworkBatchSize;
+  size_t mLocalBegin;
+  size_t mLocalEnd;
+  std::mutex mStatusMtx;
+  std::vector<std::atomic<bool>> mAliveView;
+  std::atomic<size_t> mAliveCount;
+  std::vector<std::atomic<size_t>> mInFlight;
+
+  // Tournament mode. Players only battle the players in their own arena, and each arena has its own lock, revives
+  // and winner, so nothing is shared between arenas during a round. Arena winners advance to the next round. The
+  // default is a single arena holding every player.
+  struct arena_t {
+    std::vector<size_t> players;
+    std::recursive_mutex mtx;
+    bool done = false;
+    size_t winner = 0;
+  };
+  struct round_t {
+    size_t players;
+    size_t arenas;
+    std::chrono::high_resolution_clock::time_point startTimePoint;
+    std::chrono::high_resolution_clock::time_point endTimePoint;
+  };
+  static constexpr size_t NO_ARENA = static_cast<size_t>(-1);
+  size_t mNumArenas;
+  std::vector<std::unique_ptr<arena_t>> mArenas;
+  std::vector<size_t> mArenaOfPlayer;
+  std::atomic<size_t> mArenasRemaining;
+  std::vector<round_t> mRounds;
+
+  // Random number generation, mRngs[i] is only used during player i's turns
+  uint64_t mSeed;
+  std::vector<BattleshipRandom> mRngs;
+
+  // Checkpoints
+  std::string mCheckpointFile;
+  size_t mCheckpointInterval;
+  uint64_t mCheckpointSequence;
+  std::string mResumeFile;
+  std::unique_ptr<BattleshipCheckpoint> mResume;
+  std::future<void> mCheckpointThread;
+  std::mutex mCheckpointMtx;
+  std::condition_variable mCheckpointCv;
+  // Set while a checkpoint is captured. Workers park between turns until it is cleared, so every player is saved at
+  // the same moment. mCheckpointParked counts the parked workers, and those that left the battle, under
+  // mCheckpointMtx.
+  std::atomic<bool> mCheckpointPending;
+  size_t mCheckpointParked;
+
+  // Hardware counters, mCounters[w] counts worker w
+  bool mCountersEnabled;
+  std::vector<std::unique_ptr<BattleshipCounters>> mCounters;
+  std::vector<BattleshipCounters::sample_t> mInitSamples;
+  std::vector<BattleshipCounters::sample_t> mBattleSamples;
+
+  // Shots per turn, fired with a single lock of attacker and target
+  size_t mAttackBatch;
+
+  static constexpr size_t NO_PLAYER = static_cast<size_t>(-1);
+  static constexpr size_t MAX_TRYLOCK_ATTEMPTS = 3;
+
+  // Try-lock targeting. Attacks are made outside the arena lock, and a target found locked is remembered as hot by
+  // the worker, which tries another opponent instead of waiting. Padded so workers never share a cache line.
+  struct alignas(64) targeting_t {
+    static constexpr size_t HISTORY = 4;
+    size_t hot[HISTORY] = { NO_PLAYER, NO_PLAYER, NO_PLAYER, NO_PLAYER };
+    size_t next = 0;
+    size_t attempts = 0;
+    size_t failures = 0;
+    size_t fallbacks = 0;
+
+    bool isHot(size_t aPlayer) const {
+      for (size_t player : hot) {
+        if (player == aPlayer) {
+          return true;
+        }
+      }
+      return false;
+    }
+    void remember(size_t aPlayer) {
+      hot[next] = aPlayer;
+      next = (next + 1) % HISTORY;
+    }
+  };
+  bool mTryLockTargeting;
+  std::vector<targeting_t> mTargeting;
+
+  // --engine. sequential runs the battle as an event loop on a single worker, without any locking or waiting.
+  ENGINE mEngine;
+
+  // --engine=lockstep. Every round each live player picks an opponent and a revive against mLockstepAlive, the
+  // state at the start of the round. The attacks are then applied per target in attacker order, and revives and
+  // winners are settled between rounds, so a seed gives the same battle on any number of workers.
+  struct intent_t {
+    size_t target;
+    size_t revive;
+    BattleshipBoard::attackCounts_t counts;
+    bool sunk;
+  };
+  std::vector<intent_t> mIntents;
+  std::vector<uint8_t> mLockstepAlive;
+  std::vector<size_t> mArenaAlive;
+  std::vector<size_t> mAttackers;       // attackers grouped by target, in attacker order
+  std::vector<size_t> mAttackersBegin;  // target t's attackers are [mAttackersBegin[t], mAttackersBegin[t + 1])
+  size_t mLockstepRounds;
+
+  // --games, independent two player games on boards of up to 8x8, played a vector of mGamesWidth at a time. Each is
+  // the game the sequential engine would play with its seed.
+  uint64_t mGames;
+  BattleshipGames::WIDTH mGamesWidth;
+  BattleshipGames::result_t mGamesResult;
+
+  // --huge-pages, where players and boards are allocated. mPagesObtained is what the kernel gave.
+  BattleshipMemory::PAGES mPages;
+  std::string mPagesObtained;
+
+  // --boards=lazy, boards that only store the cells they have touched
+  BattleshipBoard::STORAGE mBoards;
+
+  // --sweep, games from the scenario file played at once on up to mSweepCores workers, one CSV or JSON row each
+  std::string mSweepFile;
+  std::unique_ptr<BattleshipSweep> mSweep;
+  size_t mSweepCores;
+  bool mSweepJson;
+
+  // Monitor thread, prints a snapshot of the local players' stats every mMonitorInterval ms during the battle
+  size_t mMonitorInterval;
+  std::future<void> mMonitorThread;
+  std::mutex mMonitorMtx;
+  std::condition_variable mMonitorCv;
+  bool mMonitorDone;
+  size_t mMonitorSnapshots;
+  uint64_t mMonitorNanoseconds;
+
+  // --view, the boards of mViewPlayers redrawn by the view thread at most mViewFps times a second during the battle
+  std::vector<size_t> mViewPlayers;
+  size_t mViewFps;
+  std::unique_ptr<BattleshipView> mView;
+  std::future<void> mViewThread;
+  std::mutex mViewMtx;
+  std::condition_variable mViewCv;
+  bool mViewDone;
+  size_t mViewFrames;
+  size_t mViewCells;
+  size_t mViewBytes;
+  uint64_t mViewNanoseconds;
+
+  // Bytes held by each subsystem, for the report or predicted by --estimate without allocating any player
+  struct memoryUsage_t {
+    size_t initialCells;
+    size_t currentCells;
+    size_t boardOverhead;
+    size_t playerBytes;  // per player
+    size_t playerOverhead;
+    size_t threads;
+    size_t threadStacks;  // reserved address space, only the touched pages are resident
+    size_t logBuffer;
+    size_t traceBuffers;
+    size_t report;
+  };
+  // getrusage at the end of each phase
+  struct resources_t {
+    size_t peakRssBytes;
+    size_t minorFaults;
+    size_t majorFaults;
+    BattleshipAllocations::totals_t allocations;  // all 0 unless built with ENABLE_ALLOCATION_TRACKING
+  };
+  bool mEstimate;
+  resources_t mStartResources;
+  resources_t mInitResources;
+  resources_t mBattleResources;
+  resources_t mReportResources;
+
+  // Trace export, one span tree in every mTraceSample is recorded
+  std::string mTraceFile;
+  size_t mTraceSample;
+
   // Generated report
   std::string mReport;
 
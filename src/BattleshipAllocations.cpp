@@ -0,0 +1,232 @@
+/**
+* @Filename: BattleshipAllocations.cpp
+* @Author:   Ben Sokol <Ben>
+* @Email:    ben@bensokol.com
+* @Created:  October 18th, 2026 [11:45pm]
+* @Modified: October 19th, 2026 [2:05am]
+* @Version:  1.0.0
+*
+* Copyright (C) 2019 by Ben Sokol. All Rights Reserved.
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+#include "BattleshipAllocations.hpp"
+
+
+#ifdef ENABLE_ALLOCATION_TRACKING
+namespace {
+  // Threads past the last slot share it, its counters are atomic like the rest
+  const size_t MAX_THREADS = 256;
+
+  struct alignas(64) slot_t {
+    std::atomic<uint64_t> allocations;
+    std::atomic<uint64_t> bytes;
+    std::atomic<uint64_t> frees;
+    std::atomic<uint64_t> forbidden;
+    std::atomic<uint64_t> allowed;
+    std::atomic<uint64_t> allowedBytes;
+  };
+
+  // Zero initialized before any constructor runs, so allocations from static constructors are counted too
+  slot_t sSlots[MAX_THREADS];
+  std::atomic<size_t> sNextSlot;
+
+  thread_local slot_t *tSlot = nullptr;
+  thread_local size_t tForbidDepth = 0;
+  thread_local size_t tAllowDepth = 0;
+
+  slot_t &getSlot() {
+    if (tSlot == nullptr) {
+      const size_t slot = sNextSlot.fetch_add(1, std::memory_order_relaxed);
+      tSlot = &sSlots[slot < MAX_THREADS ? slot : MAX_THREADS - 1];
+    }
+    return *tSlot;
+  }
+
+  /****************************************************************
+  * recordAllocation:
+  *   Must not allocate. With ALLOCATION_TRACKING_ABORT a forbidden
+  *   allocation is reported with fputs rather than iostreams and
+  *   aborts, so the core dump points at the allocating call. It is
+  *   not tied to NDEBUG, which the Makefile always defines.
+  ****************************************************************/
+  void recordAllocation(size_t aBytes) {
+    slot_t &slot = getSlot();
+    slot.allocations.fetch_add(1, std::memory_order_relaxed);
+    slot.bytes.fetch_add(aBytes, std::memory_order_relaxed);
+    if (tForbidDepth > 0 && tAllowDepth > 0) {
+      slot.allowed.fetch_add(1, std::memory_order_relaxed);
+      slot.allowedBytes.fetch_add(aBytes, std::memory_order_relaxed);
+    }
+    else if (tForbidDepth > 0) {
+      slot.forbidden.fetch_add(1, std::memory_order_relaxed);
+#ifdef ALLOCATION_TRACKING_ABORT
+      std::fputs("ERROR: Heap allocation in the battle loop\n", stderr);
+      std::abort();
+#endif
+    }
+  }
+
+  void recordFree(void *aPtr) {
+    if (aPtr != nullptr) {
+      getSlot().frees.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+
+  void *allocate(size_t aBytes) {
+    recordAllocation(aBytes);
+    void *ptr = std::malloc(aBytes != 0 ? aBytes : 1);
+    if (ptr == nullptr) {
+      throw std::bad_alloc();
+    }
+    return ptr;
+  }
+
+  void *allocateAligned(size_t aBytes, std::align_val_t aAlignment) {
+    recordAllocation(aBytes);
+    void *ptr = nullptr;
+    const size_t alignment = std::max(static_cast<size_t>(aAlignment), sizeof(void *));
+    if (posix_memalign(&ptr, alignment, aBytes != 0 ? aBytes : 1) != 0) {
+      throw std::bad_alloc();
+    }
+    return ptr;
+  }
+
+  void deallocate(void *aPtr) {
+    recordFree(aPtr);
+    std::free(aPtr);
+  }
+}  // namespace
+
+
+BattleshipAllocations::Forbid::Forbid() {
+  tForbidDepth++;
+}
+
+
+BattleshipAllocations::Forbid::~Forbid() {
+  tForbidDepth--;
+}
+
+
+BattleshipAllocations::Allow::Allow() {
+  tAllowDepth++;
+}
+
+
+BattleshipAllocations::Allow::~Allow() {
+  tAllowDepth--;
+}
+
+
+bool BattleshipAllocations::isEnabled() {
+  return true;
+}
+
+
+BattleshipAllocations::totals_t BattleshipAllocations::getTotals() {
+  totals_t totals = {};
+  const size_t slots = std::min(sNextSlot.load(), MAX_THREADS);
+  for (size_t i = 0; i < slots; ++i) {
+    totals.allocations += sSlots[i].allocations.load(std::memory_order_relaxed);
+    totals.bytes += sSlots[i].bytes.load(std::memory_order_relaxed);
+    totals.frees += sSlots[i].frees.load(std::memory_order_relaxed);
+    totals.forbidden += sSlots[i].forbidden.load(std::memory_order_relaxed);
+    totals.allowed += sSlots[i].allowed.load(std::memory_order_relaxed);
+    totals.allowedBytes += sSlots[i].allowedBytes.load(std::memory_order_relaxed);
+  }
+  return totals;
+}
+
+
+// Every replaceable form of the global operator new and delete
+void *operator new(size_t aBytes) {
+  return allocate(aBytes);
+}
+void *operator new[](size_t aBytes) {
+  return allocate(aBytes);
+}
+void *operator new(size_t aBytes, const std::nothrow_t &) noexcept {
+  try {
+    return allocate(aBytes);
+  }
+  catch (const std::bad_alloc &) {
+    return nullptr;
+  }
+}
+void *operator new[](size_t aBytes, const std::nothrow_t &) noexcept {
+  return operator new(aBytes, std::nothrow);
+}
+void *operator new(size_t aBytes, std::align_val_t aAlignment) {
+  return allocateAligned(aBytes, aAlignment);
+}
+void *operator new[](size_t aBytes, std::align_val_t aAlignment) {
+  return allocateAligned(aBytes, aAlignment);
+}
+void *operator new(size_t aBytes, std::align_val_t aAlignment, const std::nothrow_t &) noexcept {
+  try {
+    return allocateAligned(aBytes, aAlignment);
+  }
+  catch (const std::bad_alloc &) {
+    return nullptr;
+  }
+}
+void *operator new[](size_t aBytes, std::align_val_t aAlignment, const std::nothrow_t &) noexcept {
+  return operator new(aBytes, aAlignment, std::nothrow);
+}
+
+void operator delete(void *aPtr) noexcept {
+  deallocate(aPtr);
+}
+void operator delete[](void *aPtr) noexcept {
+  deallocate(aPtr);
+}
+void operator delete(void *aPtr, size_t) noexcept {
+  deallocate(aPtr);
+}
+void operator delete[](void *aPtr, size_t) noexcept {
+  deallocate(aPtr);
+}
+void operator delete(void *aPtr, const std::nothrow_t &) noexcept {
+  deallocate(aPtr);
+}
+void operator delete[](void *aPtr, const std::nothrow_t &) noexcept {
+  deallocate(aPtr);
+}
+void operator delete(void *aPtr, std::align_val_t) noexcept {
+  deallocate(aPtr);
+}
+void operator delete[](void *aPtr, std::align_val_t) noexcept {
+  deallocate(aPtr);
+}
+void operator delete(void *aPtr, size_t, std::align_val_t) noexcept {
+  deallocate(aPtr);
+}
+void operator delete[](void *aPtr, size_t, std::align_val_t) noexcept {
+  deallocate(aPtr);
+}
+void operator delete(void *aPtr, std::align_val_t, const std::nothrow_t &) noexcept {
+  deallocate(aPtr);
+}
+void operator delete[](void *aPtr, std::align_val_t, const std::nothrow_t &) noexcept {
+  deallocate(aPtr);
+}
+
+#else
+
+bool BattleshipAllocations::isEnabled() {
+  return false;
+}
+
+
+BattleshipAllocations::totals_t BattleshipAllocations::getTotals() {
+  return totals_t();
+}
+
+#endif
@@ -0,0 +1,63 @@
+/**
+* @Filename: BattleshipAllocations.hpp
+* @Author:   Ben Sokol <Ben>
+* @Email:    ben@bensokol.com
+* @Created:  October 18th, 2026 [11:45pm]
+* @Modified: October 19th, 2026 [2:05am]
+* @Version:  1.0.0
+*
+* Copyright (C) 2019 by Ben Sokol. All Rights Reserved.
+*/
+
+#ifndef BATTLESHIPALLOCATIONS_HPP
+#define BATTLESHIPALLOCATIONS_HPP
+
+#include <cstdint>
+
+// Heap allocation tracking, built with ENABLE_ALLOCATION_TRACKING. The global operator new and delete are replaced
+// to count allocations, bytes and frees per thread. Code that must not allocate runs under a Forbid, and an
+// allocation under it is counted as forbidden, and also fails the run when built with ALLOCATION_TRACKING_ABORT.
+// Without the build option nothing is replaced, the totals are all 0, and Forbid and Allow compile to nothing.
+class BattleshipAllocations {
+public:
+  struct totals_t {
+    uint64_t allocations;
+    uint64_t bytes;
+    uint64_t frees;
+    uint64_t forbidden;     // allocations under a Forbid
+    uint64_t allowed;       // allocations under a Forbid lifted by an Allow
+    uint64_t allowedBytes;
+  };
+
+  class Forbid {
+  public:
+#ifdef ENABLE_ALLOCATION_TRACKING
+    Forbid();
+    ~Forbid();
+#else
+    Forbid() {}
+#endif
+    Forbid(const Forbid &) = delete;
+    Forbid &operator=(const Forbid &) = delete;
+  };
+
+  // Lifts the thread's Forbid for growth that is amortized by design, such as a table that doubles when full. The
+  // allocations are still counted, as allowed rather than forbidden.
+  class Allow {
+  public:
+#ifdef ENABLE_ALLOCATION_TRACKING
+    Allow();
+    ~Allow();
+#else
+    Allow() {}
+#endif
+    Allow(const Allow &) = delete;
+    Allow &operator=(const Allow &) = delete;
+  };
+
+  static bool isEnabled();
+  // Summed over every thread so far
+  static totals_t getTotals();
+};
+
+#endif
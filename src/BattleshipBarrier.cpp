@@ -0,0 +1,50 @@
+/**
+* @Filename: BattleshipBarrier.cpp
+* @Author:   Ben Sokol <Ben>
+* @Email:    ben@bensokol.com
+* @Created:  October 18th, 2026 [1:18pm]
+* @Modified: October 18th, 2026 [1:18pm]
+* @Version:  1.0.0
+*
+* Copyright (C) 2019 by Ben Sokol. All Rights Reserved.
+*/
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+#include "UTL_assert.h"
+
+#include "BattleshipBarrier.hpp"
+
+
+BattleshipBarrier::BattleshipBarrier(size_t aCount, size_t aSpins)
+    : mCount(aCount), mSpins(aSpins), mArrived(0), mGeneration(0) {
+  UTL_assert(mCount > 0);
+}
+
+
+void BattleshipBarrier::arriveAndWait() {
+  const size_t generation = mGeneration.load(std::memory_order_acquire);
+
+  // Last one in releases everyone
+  if (mArrived.fetch_add(1, std::memory_order_acq_rel) + 1 == mCount) {
+    mArrived.store(0, std::memory_order_relaxed);
+    {
+      std::lock_guard<std::mutex> lck(mMtx);
+      mGeneration.fetch_add(1, std::memory_order_release);
+    }
+    mCv.notify_all();
+    return;
+  }
+
+  for (size_t i = 0; i < mSpins; ++i) {
+    if (mGeneration.load(std::memory_order_acquire) != generation) {
+      return;
+    }
+    std::this_thread::yield();
+  }
+
+  std::unique_lock<std::mutex> lck(mMtx);
+  mCv.wait(lck, [&]() { return mGeneration.load(std::memory_order_acquire) != generation; });
+}
@@ -0,0 +1,37 @@
+/**
+* @Filename: BattleshipBarrier.hpp
+* @Author:   Ben Sokol <Ben>
+* @Email:    ben@bensokol.com
+* @Created:  October 18th, 2026 [1:18pm]
+* @Modified: October 18th, 2026 [1:18pm]
+* @Version:  1.0.0
+*
+* Copyright (C) 2019 by Ben Sokol. All Rights Reserved.
+*/
+
+#ifndef BATTLESHIPBARRIER_HPP
+#define BATTLESHIPBARRIER_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdlib>
+#include <mutex>
+
+// Reusable barrier. Threads spin briefly, since the last thread usually arrives within microseconds, and only then
+// block on the condition variable.
+class BattleshipBarrier {
+public:
+  explicit BattleshipBarrier(size_t aCount, size_t aSpins = 4096);
+
+  void arriveAndWait();
+
+private:
+  const size_t mCount;
+  const size_t mSpins;
+  std::atomic<size_t> mArrived;
+  std::atomic<size_t> mGeneration;
+  std::mutex mMtx;
+  std::condition_variable mCv;
+};
+
+#endif
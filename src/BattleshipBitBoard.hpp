@@ -0,0 +1,240 @@
+/**
+* @Filename: BattleshipBitBoard.hpp
+* @Author:   Ben Sokol <Ben>
+* @Email:    ben@bensokol.com
+* @Created:  October 18th, 2026 [4:40pm]
+* @Modified: October 18th, 2026 [11:20pm]
+* @Version:  1.0.0
+*
+* Copyright (C) 2019 by Ben Sokol. All Rights Reserved.
+*/
+
+#ifndef BATTLESHIPBITBOARD_HPP
+#define BATTLESHIPBITBOARD_HPP
+
+#include <array>
+#include <cstdint>
+#include <string>
+
+#include "UTL_assert.h"
+
+#include "BattleshipBoard.hpp"
+#include "BattleshipRandom.hpp"
+
+// Board of up to LINES x LINES cells, LINES ≤ 64. Each column is a word with one bit per row, since targets are
+// searched for down each column. Cell states are two bits: mShips ('O' or '*') and mAttacked ('.' or '*').
+template <size_t LINES>
+class BattleshipBitBoard : public BattleshipBoard {
+  static_assert(LINES > 0 && LINES <= 64, "A column must fit in a word");
+
+public:
+  BattleshipBitBoard(size_t aSize, size_t aTotalTargets, uint64_t aSeed)
+      : mSize(aSize),
+        mRowMask(aSize == 64 ? ~uint64_t(0) : (uint64_t(1) << aSize) - 1),
+        mTotalTargets(aTotalTargets),
+        mTargetsAvailable(aTotalTargets),
+        mNotAttackedSpotsRemaining(aSize * aSize),
+        mInitialShips(),
+        mShips(),
+        mAttacked(),
+        mRng(aSeed) {
+    UTL_assert(mSize > 0 && mSize <= LINES);
+    UTL_assert(mTotalTargets <= (mSize * mSize));
+
+    for (size_t i = 0; i < mTotalTargets; ++i) {
+      const coordinate_t start = randomCoordinate(mRng, mSize);
+      const coordinate_t coordinate = findFrom(mShips, start.getCol(), start.getRow());
+      mShips[coordinate.getCol()] |= bit(coordinate.getRow());
+    }
+    mInitialShips = mShips;
+  }
+
+  BattleshipBitBoard(size_t aSize, const state_t &aState, const uint8_t *aInitialCells, const uint8_t *aCurrentCells)
+      : mSize(aSize),
+        mRowMask(aSize == 64 ? ~uint64_t(0) : (uint64_t(1) << aSize) - 1),
+        mTotalTargets(aState.totalTargets),
+        mTargetsAvailable(aState.targetsAvailable),
+        mNotAttackedSpotsRemaining(aState.notAttackedSpotsRemaining),
+        mInitialShips(),
+        mShips(),
+        mAttacked(),
+        mRng(aState.rngState) {
+    UTL_assert(mSize > 0 && mSize <= LINES);
+    for (size_t i = 0; i < mSize * mSize; ++i) {
+      const size_t shift = (i % 4) * 2;
+      const coordinate_t cell = coordinate_t::ofIndex(i, mSize);
+      const size_t row = cell.getRow();
+      const size_t col = cell.getCol();
+      if (((aInitialCells[i / 4] >> shift) & 1) != 0) {
+        mInitialShips[col] |= bit(row);
+      }
+      const uint8_t code = (aCurrentCells[i / 4] >> shift) & 3;
+      mShips[col] |= (code & 1) ? bit(row) : 0;
+      mAttacked[col] |= (code & 2) ? bit(row) : 0;
+    }
+  }
+
+  void saveState(state_t &aState, uint8_t *aInitialCells, uint8_t *aCurrentCells) const override {
+    aState.totalTargets = mTotalTargets;
+    aState.targetsAvailable = mTargetsAvailable;
+    aState.notAttackedSpotsRemaining = mNotAttackedSpotsRemaining;
+    aState.rngState = mRng.getState();
+
+    for (size_t i = 0; i < packedCellBytes(mSize); ++i) {
+      aInitialCells[i] = 0;
+      aCurrentCells[i] = 0;
+    }
+    for (size_t i = 0; i < mSize * mSize; ++i) {
+      const size_t shift = (i % 4) * 2;
+      const coordinate_t cell = coordinate_t::ofIndex(i, mSize);
+      aInitialCells[i / 4] |= static_cast<uint8_t>(initialCode(cell.getRow(), cell.getCol()) << shift);
+      aCurrentCells[i / 4] |= static_cast<uint8_t>(currentCode(cell.getRow(), cell.getCol()) << shift);
+    }
+  }
+
+  // Cells are stored inline, one word per column: mInitialShips, then mShips and mAttacked
+  static footprint_t footprint(size_t) {
+    footprint_t footprint;
+    footprint.initialCells = sizeof(std::array<uint64_t, LINES>);
+    footprint.currentCells = 2 * sizeof(std::array<uint64_t, LINES>);
+    footprint.overhead = sizeof(BattleshipBitBoard<LINES>) - footprint.initialCells - footprint.currentCells;
+    return footprint;
+  }
+
+  footprint_t getFootprint() const override {
+    return footprint(mSize);
+  }
+
+  bool isAlive() override {
+    return mTargetsAvailable > 0;
+  }
+
+  BattleshipBoard::coordinate_t getAvailableTarget() override {
+    if (mNotAttackedSpotsRemaining == 0) {
+      return coordinate_t();
+    }
+    const coordinate_t start = randomCoordinate(mRng, mSize);
+    return findFrom(mAttacked, start.getCol(), start.getRow());
+  }
+
+  size_t getRemainingTargets() override {
+    return mTargetsAvailable;
+  }
+
+  ATTACK_RESULT attackLocation(coordinate_t &coordinate) override {
+    const uint64_t cell = bit(coordinate.getRow());
+    const bool ship = (mShips[coordinate.getCol()] & cell) != 0;
+    if ((mAttacked[coordinate.getCol()] & cell) != 0) {
+      return ship ? ATTACK_RESULT_SECONDARY_HIT : ATTACK_RESULT_SECONDARY_MISS;
+    }
+
+    mAttacked[coordinate.getCol()] |= cell;
+    mNotAttackedSpotsRemaining--;
+    markView(coordinate.index(mSize), ship ? 3 : 2);
+    if (ship) {
+      mTargetsAvailable--;
+      return ATTACK_RESULT_INITIAL_HIT;
+    }
+    return ATTACK_RESULT_INITIAL_MISS;
+  }
+
+  // Branch free: the result is (attacked before << 1) | !ship, and the counters are settled once for the whole span.
+  // Attacks are applied in order rather than gathered, since a later cell may repeat an earlier one.
+  void attackLocations(attack_t *aAttacks, size_t aCount, attackCounts_t &aCounts) override {
+    static_assert(ATTACK_RESULT_INITIAL_HIT == 0 && ATTACK_RESULT_INITIAL_MISS == 1
+                      && ATTACK_RESULT_SECONDARY_HIT == 2 && ATTACK_RESULT_SECONDARY_MISS == 3,
+                  "Results are computed from the cell bits");
+    size_t counts[COUNT] = {};
+    for (size_t i = 0; i < aCount; ++i) {
+      const size_t row = aAttacks[i].cell.getRow();
+      const size_t col = aAttacks[i].cell.getCol();
+      uint64_t &attacked = mAttacked[col];
+      const size_t result = (((attacked >> row) & 1) << 1) | (((mShips[col] >> row) & 1) ^ 1);
+      attacked |= bit(row);
+      aAttacks[i].result = static_cast<uint32_t>(result);
+      markView(row * mSize + col, static_cast<uint8_t>(2 | ((result & 1) ^ 1)));
+      counts[result]++;
+    }
+
+    mTargetsAvailable -= counts[ATTACK_RESULT_INITIAL_HIT];
+    mNotAttackedSpotsRemaining -= counts[ATTACK_RESULT_INITIAL_HIT] + counts[ATTACK_RESULT_INITIAL_MISS];
+    for (size_t i = 0; i < COUNT; ++i) {
+      aCounts.results[i] += counts[i];
+    }
+  }
+
+  // Same placement as BattleshipBoardGeneric::revive, so both boards stay in step
+  void revive(size_t numberOfTargetsToAdd) override {
+    for (size_t i = 0; i < numberOfTargetsToAdd; ++i) {
+      const size_t index = reviveIndex(mRng, mSize, [this](size_t aIndex) {
+        const coordinate_t cell = coordinate_t::ofIndex(aIndex, mSize);
+        return currentCode(cell.getRow(), cell.getCol()) == 1;
+      });
+      if (index == mSize * mSize) {
+        return;
+      }
+      const coordinate_t coordinate = coordinate_t::ofIndex(index, mSize);
+      const uint64_t cell = bit(coordinate.getRow());
+      if ((mAttacked[coordinate.getCol()] & cell) != 0) {
+        mNotAttackedSpotsRemaining++;
+      }
+      mShips[coordinate.getCol()] |= cell;
+      mAttacked[coordinate.getCol()] &= ~cell;
+      markView(index, 1);
+      mTotalTargets++;
+      mTargetsAvailable++;
+    }
+  }
+
+protected:
+  std::string printCells(whichBoard board) override {
+    std::string str = "";
+    for (size_t row = 0; row < mSize; ++row) {
+      for (size_t col = 0; col < mSize; ++col) {
+        str += cellOfCode(board == INITIAL ? initialCode(row, col) : currentCode(row, col));
+      }
+      str += "\n";
+    }
+    return str;
+  }
+
+private:
+  static uint64_t bit(size_t aRow) {
+    return uint64_t(1) << aRow;
+  }
+
+  uint8_t initialCode(size_t aRow, size_t aCol) const {
+    return static_cast<uint8_t>((mInitialShips[aCol] >> aRow) & 1);
+  }
+
+  uint8_t currentCode(size_t aRow, size_t aCol) const {
+    return static_cast<uint8_t>(((mShips[aCol] >> aRow) & 1) | (((mAttacked[aCol] >> aRow) & 1) << 1));
+  }
+
+  // First cell at or after (aCol, aRow) whose bit in aWords is clear, going down each column and wrapping from the
+  // last column to the first. A whole column is tested with one mask and a count of trailing zeros.
+  coordinate_t findFrom(const std::array<uint64_t, LINES> &aWords, size_t aCol, size_t aRow) const {
+    for (size_t i = 0; i <= mSize; ++i) {
+      const uint64_t candidates = ~aWords[aCol] & mRowMask & (~uint64_t(0) << aRow);
+      if (candidates != 0) {
+        return coordinate_t(aCol, static_cast<size_t>(__builtin_ctzll(candidates)));
+      }
+      aRow = 0;
+      aCol = (aCol + 1 < mSize) ? aCol + 1 : 0;
+    }
+    UTL_assert_always();
+    throw("ERROR: Unable to find a free cell.");
+  }
+
+  const size_t mSize;
+  const uint64_t mRowMask;
+  size_t mTotalTargets;
+  size_t mTargetsAvailable;
+  size_t mNotAttackedSpotsRemaining;
+  std::array<uint64_t, LINES> mInitialShips;
+  std::array<uint64_t, LINES> mShips;
+  std::array<uint64_t, LINES> mAttacked;
+  BattleshipRandom mRng;
+};
+
+#endif
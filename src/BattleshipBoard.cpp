@@ -3,109 +3,152 @@
 * @Author:   Ben Sokol <Ben>
 * @Email:    ben@bensokol.com
 * @Created:  February 19th, 2019 [10:58am]
-* @Modified: February 22nd, 2019 [11:18pm]
+* @Modified: October 18th, 2026 [10:55pm]
 * @Version:  1.0.0
 *
 * Copyright (C) 2019 by Ben Sokol. All Rights Reserved.
 */
 
-#include <mutex>
-#include <random>
+#include <cstdint>
+#include <memory>
+#include <string>
 
 #include "UTL_assert.h"
 
+#include "BattleshipBitBoard.hpp"
+#include "BattleshipBoardGeneric.hpp"
+#include "BattleshipLazyBoard.hpp"
+#include "BattleshipMemory.hpp"
+
 #include "BattleshipBoard.hpp"
 
-BattleshipBoard::BattleshipBoard(size_t aSize, size_t aTotalTargets)
-    : mSize(aSize),
-      mTotalTargets(aTotalTargets),
-      mTargetsAvailable(aTotalTargets),
-      mNotAttackedSpotsRemaining(aSize * aSize),
-      mInitialBoard(std::vector<std::vector<char>>(mSize, std::vector<char>(mSize, '_'))),
-      mBoard(std::vector<std::vector<char>>(mSize, std::vector<char>(mSize, '_'))) {
-  UTL_assert(mTotalTargets <= (mSize * mSize));
-
-  std::random_device rd;
-  for (size_t i = 0; i < mTotalTargets; ++i) {
-    coordinate_t coordinate((rd() % mSize), (rd() % mSize));
-
-    // Find and add targets to board
-    for (size_t j = 0;; ++j) {
-      UTL_assert(j < (mSize * mSize));
-      if (j >= (mSize * mSize)) {
-        // Should never reach here.
-        throw("ERROR: Couldnt find free spot to add target.");
-      }
-      else if (mBoard[coordinate.row][coordinate.col] == '_') {
-        mBoard[coordinate.row][coordinate.col] = 'O';
-        mInitialBoard[coordinate.row][coordinate.col] = 'O';
-        break;
-      }
-      if (coordinate.row < (mSize - 1)) {
-        coordinate.row++;
-      }
-      else if (coordinate.col < (mSize - 1)) {
-        coordinate.row = 0;
-        coordinate.col++;
-      }
-      else {
-        coordinate.row = 0;
-        coordinate.col = 0;
-      }
-    }
+// Cells are packed 2 bits each in checkpoints
+static const char CELL_CODES[4] = { '_', 'O', '.', '*' };
+
+
+/****************************************************************
+* create:
+*   The bitboard is instantiated for a few fixed line counts, so
+*   its arrays have a compile time size.
+****************************************************************/
+std::unique_ptr<BattleshipBoard> BattleshipBoard::create(size_t aSize,
+                                                         size_t aTotalTargets,
+                                                         uint64_t aSeed,
+                                                         STORAGE aStorage) {
+  if (aStorage == STORAGE_LAZY) {
+    return std::unique_ptr<BattleshipBoard>(new BattleshipLazyBoard(aSize, aTotalTargets, aSeed));
+  }
+  else if (aSize <= 8) {
+    return std::unique_ptr<BattleshipBoard>(new BattleshipBitBoard<8>(aSize, aTotalTargets, aSeed));
+  }
+  else if (aSize <= 16) {
+    return std::unique_ptr<BattleshipBoard>(new BattleshipBitBoard<16>(aSize, aTotalTargets, aSeed));
+  }
+  else if (aSize <= 32) {
+    return std::unique_ptr<BattleshipBoard>(new BattleshipBitBoard<32>(aSize, aTotalTargets, aSeed));
   }
+  else if (aSize <= 64) {
+    return std::unique_ptr<BattleshipBoard>(new BattleshipBitBoard<64>(aSize, aTotalTargets, aSeed));
+  }
+  return std::unique_ptr<BattleshipBoard>(new BattleshipBoardGeneric(aSize, aTotalTargets, aSeed));
+}
+
+
+std::unique_ptr<BattleshipBoard> BattleshipBoard::restore(size_t aSize,
+                                                          const state_t &aState,
+                                                          const uint8_t *aInitialCells,
+                                                          const uint8_t *aCurrentCells) {
+  if (aSize <= 8) {
+    return std::unique_ptr<BattleshipBoard>(new BattleshipBitBoard<8>(aSize, aState, aInitialCells, aCurrentCells));
+  }
+  else if (aSize <= 16) {
+    return std::unique_ptr<BattleshipBoard>(new BattleshipBitBoard<16>(aSize, aState, aInitialCells, aCurrentCells));
+  }
+  else if (aSize <= 32) {
+    return std::unique_ptr<BattleshipBoard>(new BattleshipBitBoard<32>(aSize, aState, aInitialCells, aCurrentCells));
+  }
+  else if (aSize <= 64) {
+    return std::unique_ptr<BattleshipBoard>(new BattleshipBitBoard<64>(aSize, aState, aInitialCells, aCurrentCells));
+  }
+  return std::unique_ptr<BattleshipBoard>(new BattleshipBoardGeneric(aSize, aState, aInitialCells, aCurrentCells));
+}
+
+
+BattleshipBoard::footprint_t BattleshipBoard::estimateFootprint(size_t aSize, STORAGE aStorage) {
+  if (aStorage == STORAGE_LAZY) {
+    return BattleshipLazyBoard::footprint(aSize);
+  }
+  else if (aSize <= 8) {
+    return BattleshipBitBoard<8>::footprint(aSize);
+  }
+  else if (aSize <= 16) {
+    return BattleshipBitBoard<16>::footprint(aSize);
+  }
+  else if (aSize <= 32) {
+    return BattleshipBitBoard<32>::footprint(aSize);
+  }
+  else if (aSize <= 64) {
+    return BattleshipBitBoard<64>::footprint(aSize);
+  }
+  return BattleshipBoardGeneric::footprint(aSize);
 }
 
 
 BattleshipBoard::~BattleshipBoard() {}
 
 
-bool BattleshipBoard::isAlive() {
-  return mTargetsAvailable > 0;
+void *BattleshipBoard::operator new(size_t aBytes) {
+  return BattleshipMemory::allocate(aBytes);
 }
 
 
-BattleshipBoard::coordinate_t BattleshipBoard::getAvailableTarget() {
-  std::random_device rd;
-
-  if (mNotAttackedSpotsRemaining == 0) {
-    return coordinate_t();
-  }
-
-  coordinate_t coordinate((rd() % mSize), (rd() % mSize));
-  // for (size_t j = 0; j < mSize; ++j) {
-  //   for (size_t k = 0; k < mSize; ++k) {
-  //     if (mBoard[coordinate.row][coordinate.col] == '_' || mBoard[coordinate.row][coordinate.col] == 'O') {
-  //       break;
-  //     }
-  //     coordinate.row = (coordinate.row + k) % mSize;
-  //   }
-  //   if (mBoard[coordinate.row][coordinate.col] == '_' || mBoard[coordinate.row][coordinate.col] == 'O') {
-  //     break;
-  //   }
-  //   coordinate.col = (coordinate.col + j) % mSize;
-  // }
-  for (size_t i = 0;; ++i) {
-    UTL_assert(i < (mSize * mSize));
-    if (i >= (mSize * mSize)) {
-      throw("ERROR: Unable to find target, but mNotAttackedSpotsRemaining > 0.");
-    }
-    else if (mBoard[coordinate.row][coordinate.col] == '_' || mBoard[coordinate.row][coordinate.col] == 'O') {
-      break;
-    }
-    else if (coordinate.row < (mSize - 1)) {
-      coordinate.row++;
-    }
-    else if (coordinate.col < (mSize - 1)) {
-      coordinate.row = 0;
-      coordinate.col++;
-    }
-    else {
-      coordinate.row = 0;
-      coordinate.col = 0;
+void BattleshipBoard::operator delete(void *aPtr) {
+  BattleshipMemory::deallocate(aPtr);
+}
+
+
+size_t BattleshipBoard::packedCellBytes(size_t aSize) {
+  return (aSize * aSize + 3) / 4;
+}
+
+
+BattleshipBoard::coordinate_t BattleshipBoard::randomCoordinate(BattleshipRandom &aRng, size_t aSize) {
+  const size_t col = aRng() % aSize;
+  const size_t row = aRng() % aSize;
+  return coordinate_t(col, row);
+}
+
+
+char BattleshipBoard::cellOfCode(uint8_t aCode) {
+  return CELL_CODES[aCode & 3];
+}
+
+
+uint8_t BattleshipBoard::codeOfCell(char aCell) {
+  return aCell == 'O' ? 1 : (aCell == '.' ? 2 : (aCell == '*' ? 3 : 0));
+}
+
+
+void BattleshipBoard::setView(BattleshipView::board_t *aView) {
+  mView = aView;
+  if (mView != nullptr) {
+    const std::string cells = printCells(CURRENT);
+    size_t index = 0;
+    for (char cell : cells) {
+      if (cell != '\n') {
+        mView->mark(index++, codeOfCell(cell));
+      }
     }
   }
-  return coordinate;
+}
+
+
+void BattleshipBoard::attackLocations(attack_t *aAttacks, size_t aCount, attackCounts_t &aCounts) {
+  for (size_t i = 0; i < aCount; ++i) {
+    const ATTACK_RESULT result = attackLocation(aAttacks[i].cell);
+    aAttacks[i].result = result;
+    aCounts.results[result]++;
+  }
 }
 
 
@@ -132,81 +175,7 @@ std::string BattleshipBoard::printBoard(whichBoard board, size_t playerNum) {
       UTL_assert_always();
     }
   }
-  std::vector<std::vector<char>> *boardToPrint = nullptr;
-  if (board == INITIAL) {
-    boardToPrint = &mInitialBoard;
-  }
-  else if (board == CURRENT) {
-    boardToPrint = &mBoard;
-  }
-  else {
-    UTL_assert_always();
-  }
-  if (boardToPrint) {
-    for (std::vector<char> &vec : *boardToPrint) {
-      std::string tempStr = "";
-      tempStr.resize(vec.size());
-      std::copy(vec.begin(), vec.end(), tempStr.begin());
-      str += tempStr;
-      str += "\n";
-    }
-  }
+  str += printCells(board);
   str += "\n";
   return str;
 }
-
-size_t BattleshipBoard::getRemainingTargets() {
-  return mTargetsAvailable;
-}
-
-BattleshipBoard::ATTACK_RESULT BattleshipBoard::attackLocation(coordinate_t &coordinate) {
-  if (mBoard[coordinate.row][coordinate.col] == '_') {
-    mBoard[coordinate.row][coordinate.col] = '.';
-    mNotAttackedSpotsRemaining--;
-    return ATTACK_RESULT_INITIAL_MISS;
-  }
-  else if (mBoard[coordinate.row][coordinate.col] == 'O') {
-    mBoard[coordinate.row][coordinate.col] = '*';
-    mTargetsAvailable--;
-    mNotAttackedSpotsRemaining--;
-    return ATTACK_RESULT_INITIAL_HIT;
-  }
-  else if (mBoard[coordinate.row][coordinate.col] == '.') {
-    return ATTACK_RESULT_SECONDARY_MISS;
-  }
-  else if (mBoard[coordinate.row][coordinate.col] == '*') {
-    return ATTACK_RESULT_SECONDARY_HIT;
-  }
-  else {
-    return COUNT;
-  }
-}
-
-
-void BattleshipBoard::revive(size_t numberOfTargetsToAdd) {
-  std::random_device rd;
-
-  for (size_t i = 0; i < numberOfTargetsToAdd; ++i) {
-    coordinate_t coordinate((rd() % mSize), (rd() % mSize));
-    bool foundTarget = false;
-
-    // Find and add targets to board
-    for (size_t j = 0; j < mSize && !foundTarget; ++j) {
-      for (size_t k = 0; k < mSize && !foundTarget; ++k) {
-        if (mBoard[coordinate.row][coordinate.col] != 'O') {
-          foundTarget = true;
-          break;
-        }
-        coordinate.col = (coordinate.col + k) % mSize;
-      }
-      if (mBoard[coordinate.row][coordinate.col] != 'O') {
-        break;
-      }
-      coordinate.row = (coordinate.row + j) % mSize;
-    }
-    mBoard[coordinate.row][coordinate.col] = 'O';
-    mTotalTargets++;
-    mTargetsAvailable++;
-    mNotAttackedSpotsRemaining++;
-  }
-}
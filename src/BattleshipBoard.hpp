@@ -3,7 +3,7 @@
 * @Author:   Ben Sokol <Ben>
 * @Email:    ben@bensokol.com
 * @Created:  February 19th, 2019 [10:57am]
-* @Modified: February 22nd, 2019 [9:31pm]
+* @Modified: October 18th, 2026 [11:20pm]
 * @Version:  1.0.0
 *
 * Copyright (C) 2019 by Ben Sokol. All Rights Reserved.
@@ -12,47 +12,60 @@
 #ifndef BATTLESHIPBOARD_HPP
 #define BATTLESHIPBOARD_HPP
 
+#include <cstdint>
 #include <limits>
-#include <mutex>
+#include <memory>
 #include <string>
-#include <vector>
 
+#include "BattleshipRandom.hpp"
+#include "BattleshipView.hpp"
 
+
+// Interface of a player's board. create picks the storage for the board size: a bitboard for N≤64, or a grid of
+// chars otherwise. Both place targets and pick coordinates in the same order, so a seed plays out the same either way.
+// Lazy boards place their targets differently, so the same seed plays a different game.
 class BattleshipBoard {
 public:
+  // A cell packed in 32 bits, the row in the high half and the column in the low half, so a line holds at most
+  // MAX_LINES cells. The invalid coordinate has every bit set.
   class coordinate_t {
-    friend class BattleshipBoard;
-
   public:
-    coordinate_t(size_t aCol, size_t aRow) {
-      col = aCol;
-      row = aRow;
+    static const size_t MAX_LINES = 0xFFFF;
+
+    constexpr coordinate_t(size_t aCol, size_t aRow) : mCell(static_cast<uint32_t>((aRow << 16) | aCol)) {}
+    constexpr coordinate_t() : mCell(~uint32_t(0)) {}
+
+    // Cell aIndex of a row-major aSize x aSize board, split with a shift and mask if aSize is a power of two
+    static constexpr coordinate_t ofIndex(size_t aIndex, size_t aSize) {
+      return (aSize & (aSize - 1)) == 0
+                 ? coordinate_t(aIndex & (aSize - 1), aIndex >> __builtin_ctzll(static_cast<unsigned long long>(aSize)))
+                 : coordinate_t(aIndex % aSize, aIndex / aSize);
     }
-    coordinate_t() {
-      row = std::numeric_limits<size_t>::max();
-      col = std::numeric_limits<size_t>::max();
+    constexpr size_t index(size_t aSize) const {
+      return getRow() * aSize + getCol();
     }
-    size_t getCol() const {
-      return col;
+
+    constexpr size_t getCol() const {
+      return mCell & 0xFFFF;
     }
-    size_t getRow() const {
-      return row;
+    constexpr size_t getRow() const {
+      return mCell >> 16;
     }
     void setCol(size_t aCol) {
-      col = aCol;
+      mCell = (mCell & 0xFFFF0000) | static_cast<uint32_t>(aCol);
     }
     void setRow(size_t aRow) {
-      row = aRow;
+      mCell = (mCell & 0xFFFF) | static_cast<uint32_t>(aRow << 16);
     }
 
-    size_t invalid() const {
-      return std::numeric_limits<size_t>::max();
+    constexpr size_t invalid() const {
+      return MAX_LINES;
     }
 
   private:
-    size_t col;
-    size_t row;
+    uint32_t mCell;
   };
+  static_assert(sizeof(coordinate_t) == 4, "Coordinates are queued and batched by value");
 
   enum whichBoard { INITIAL, CURRENT };
   enum ATTACK_RESULT {
@@ -63,30 +76,126 @@ public:
     COUNT
   };
 
-  BattleshipBoard(size_t aSize, size_t aTotalTargets);
-  ~BattleshipBoard();
+  // One attack in a bulk attack. The board reads cell and fills in result.
+  struct attack_t {
+    uint32_t attacker;
+    uint32_t target;
+    coordinate_t cell;
+    uint32_t result;  // ATTACK_RESULT
+  };
+  static_assert(sizeof(attack_t) == 16, "Attack records are 16 bytes");
+
+  // Number of each ATTACK_RESULT in a bulk attack
+  struct attackCounts_t {
+    size_t results[COUNT] = {};
+  };
+
+  // Bytes used by a board
+  struct footprint_t {
+    size_t initialCells;
+    size_t currentCells;
+    size_t overhead;
+  };
+
+  // Everything but the cells, as stored in a checkpoint
+  struct state_t {
+    uint64_t totalTargets;
+    uint64_t targetsAvailable;
+    uint64_t notAttackedSpotsRemaining;
+    uint64_t rngState;
+  };
+
+  // How a board holds its cells, --boards
+  enum STORAGE {
+    STORAGE_EAGER,  // every cell, with the targets placed by the constructor
+    STORAGE_LAZY,   // only the touched cells, see BattleshipLazyBoard
+    STORAGE_COUNT
+  };
+
+  static std::unique_ptr<BattleshipBoard> create(size_t aSize,
+                                                 size_t aTotalTargets,
+                                                 uint64_t aSeed,
+                                                 STORAGE aStorage = STORAGE_EAGER);
+  static std::unique_ptr<BattleshipBoard> restore(size_t aSize,
+                                                  const state_t &aState,
+                                                  const uint8_t *aInitialCells,
+                                                  const uint8_t *aCurrentCells);
+  virtual ~BattleshipBoard();
+
+  // Boards are allocated from BattleshipMemory
+  static void *operator new(size_t aBytes);
+  static void operator delete(void *aPtr);
+
+  static size_t packedCellBytes(size_t aSize);
+  // Footprint of the board create would make, without making it
+  static footprint_t estimateFootprint(size_t aSize, STORAGE aStorage = STORAGE_EAGER);
+  virtual footprint_t getFootprint() const = 0;
+  virtual void saveState(state_t &aState, uint8_t *aInitialCells, uint8_t *aCurrentCells) const = 0;
 
   std::string printBoard(whichBoard board = CURRENT, size_t playerNum = std::numeric_limits<size_t>::max());
   std::string printCurrentBoard(size_t playerNum = std::numeric_limits<size_t>::max());
   std::string printInitialBoard(size_t playerNum = std::numeric_limits<size_t>::max());
 
-  bool isAlive();
+  virtual bool isAlive() = 0;
+
+  virtual BattleshipBoard::coordinate_t getAvailableTarget() = 0;
+
+  virtual size_t getRemainingTargets() = 0;
 
-  BattleshipBoard::coordinate_t getAvailableTarget();
+  virtual ATTACK_RESULT attackLocation(coordinate_t &coordinate) = 0;
 
-  size_t getRemainingTargets();
+  // Applies aCount attacks in order, so a cell repeated in the span is a secondary hit or miss the second time
+  virtual void attackLocations(attack_t *aAttacks, size_t aCount, attackCounts_t &aCounts);
 
-  ATTACK_RESULT attackLocation(coordinate_t &coordinate);
+  // Places numberOfTargetsToAdd targets on cells that are not targets, each in O(1) expected time. A placed cell is
+  // untouched again, so it only adds to the untouched cells if it had been attacked.
+  virtual void revive(size_t numberOfTargetsToAdd = 2) = 0;
+
+  // --view, every cell this board changes is marked on aView. Marks all cells so the first frame draws the board.
+  void setView(BattleshipView::board_t *aView);
+
+protected:
+  void markView(size_t aIndex, uint8_t aCode) {
+    if (mView != nullptr) {
+      mView->mark(aIndex, aCode);
+    }
+  }
+
+  // One line per row, each cell is '_' (empty), 'O' (target), '.' (miss) or '*' (hit)
+  virtual std::string printCells(whichBoard board) = 0;
+
+  // Draws the column, then the row. Drawing both inside one constructor call would leave the order to the compiler.
+  static coordinate_t randomCoordinate(BattleshipRandom &aRng, size_t aSize);
+
+  // Where revive places a target: a random cell that aIsTarget rejects, or the next such cell in row-major order once
+  // REVIVE_DRAWS draws have all hit targets. A sunk board has no targets, so the first draw all but always lands.
+  // Returns aSize² if every cell is a target.
+  static const size_t REVIVE_DRAWS = 4;
+  template <typename IsTarget>
+  static size_t reviveIndex(BattleshipRandom &aRng, size_t aSize, IsTarget aIsTarget) {
+    const size_t cells = aSize * aSize;
+    size_t index = 0;
+    for (size_t draw = 0; draw < REVIVE_DRAWS; ++draw) {
+      index = aRng() % cells;
+      if (!aIsTarget(index)) {
+        return index;
+      }
+    }
+    for (size_t i = 0; i < cells; ++i) {
+      if (!aIsTarget(index)) {
+        return index;
+      }
+      index = (index + 1 < cells) ? index + 1 : 0;
+    }
+    return cells;
+  }
 
-  void revive(size_t numberOfTargetsToAdd = 2);
+  // Cells are packed 2 bits each in checkpoints
+  static char cellOfCode(uint8_t aCode);
+  static uint8_t codeOfCell(char aCell);
 
 private:
-  const size_t mSize;
-  size_t mTotalTargets;
-  size_t mTargetsAvailable;
-  size_t mNotAttackedSpotsRemaining;
-  std::vector<std::vector<char>> mInitialBoard;
-  std::vector<std::vector<char>> mBoard;
+  BattleshipView::board_t *mView = nullptr;
 };
 
 #endif
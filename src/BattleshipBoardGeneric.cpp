@@ -0,0 +1,209 @@
+/**
+* @Filename: BattleshipBoardGeneric.cpp
+* @Author:   Ben Sokol <Ben>
+* @Email:    ben@bensokol.com
+* @Created:  October 18th, 2026 [4:40pm]
+* @Modified: October 19th, 2026 [1:15am]
+* @Version:  1.0.0
+*
+* Copyright (C) 2019 by Ben Sokol. All Rights Reserved.
+*/
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "UTL_assert.h"
+
+#include "BattleshipBoardGeneric.hpp"
+
+
+BattleshipBoardGeneric::BattleshipBoardGeneric(size_t aSize, size_t aTotalTargets, uint64_t aSeed)
+    : mSize(aSize),
+      mTotalTargets(aTotalTargets),
+      mTargetsAvailable(aTotalTargets),
+      mNotAttackedSpotsRemaining(aSize * aSize),
+      mInitialBoard(mSize * mSize, '_'),
+      mBoard(mSize * mSize, '_'),
+      mRng(aSeed) {
+  UTL_assert(mTotalTargets <= (mSize * mSize));
+
+  for (size_t i = 0; i < mTotalTargets; ++i) {
+    coordinate_t coordinate = randomCoordinate(mRng, mSize);
+
+    // Find and add targets to board
+    for (size_t j = 0;; ++j) {
+      UTL_assert(j < (mSize * mSize));
+      if (j >= (mSize * mSize)) {
+        // Should never reach here.
+        throw("ERROR: Couldnt find free spot to add target.");
+      }
+      else if (mBoard[coordinate.index(mSize)] == '_') {
+        mBoard[coordinate.index(mSize)] = 'O';
+        mInitialBoard[coordinate.index(mSize)] = 'O';
+        break;
+      }
+      if (coordinate.getRow() < (mSize - 1)) {
+        coordinate.setRow(coordinate.getRow() + 1);
+      }
+      else if (coordinate.getCol() < (mSize - 1)) {
+        coordinate.setRow(0);
+        coordinate.setCol(coordinate.getCol() + 1);
+      }
+      else {
+        coordinate.setRow(0);
+        coordinate.setCol(0);
+      }
+    }
+  }
+}
+
+
+BattleshipBoardGeneric::BattleshipBoardGeneric(size_t aSize,
+                                               const state_t &aState,
+                                               const uint8_t *aInitialCells,
+                                               const uint8_t *aCurrentCells)
+    : mSize(aSize),
+      mTotalTargets(aState.totalTargets),
+      mTargetsAvailable(aState.targetsAvailable),
+      mNotAttackedSpotsRemaining(aState.notAttackedSpotsRemaining),
+      mInitialBoard(mSize * mSize, '_'),
+      mBoard(mSize * mSize, '_'),
+      mRng(aState.rngState) {
+  for (size_t i = 0; i < mSize * mSize; ++i) {
+    const size_t shift = (i % 4) * 2;
+    mInitialBoard[i] = cellOfCode(aInitialCells[i / 4] >> shift);
+    mBoard[i] = cellOfCode(aCurrentCells[i / 4] >> shift);
+  }
+}
+
+
+BattleshipBoardGeneric::~BattleshipBoardGeneric() {}
+
+
+void BattleshipBoardGeneric::saveState(state_t &aState, uint8_t *aInitialCells, uint8_t *aCurrentCells) const {
+  aState.totalTargets = mTotalTargets;
+  aState.targetsAvailable = mTargetsAvailable;
+  aState.notAttackedSpotsRemaining = mNotAttackedSpotsRemaining;
+  aState.rngState = mRng.getState();
+
+  std::fill(aInitialCells, aInitialCells + packedCellBytes(mSize), 0);
+  std::fill(aCurrentCells, aCurrentCells + packedCellBytes(mSize), 0);
+  for (size_t i = 0; i < mSize * mSize; ++i) {
+    const size_t shift = (i % 4) * 2;
+    aInitialCells[i / 4] |= static_cast<uint8_t>(codeOfCell(mInitialBoard[i]) << shift);
+    aCurrentCells[i / 4] |= static_cast<uint8_t>(codeOfCell(mBoard[i]) << shift);
+  }
+}
+
+
+BattleshipBoard::footprint_t BattleshipBoardGeneric::footprint(size_t aSize) {
+  footprint_t footprint;
+  footprint.initialCells = aSize * aSize;
+  footprint.currentCells = aSize * aSize;
+  footprint.overhead = sizeof(BattleshipBoardGeneric);
+  return footprint;
+}
+
+
+BattleshipBoard::footprint_t BattleshipBoardGeneric::getFootprint() const {
+  footprint_t footprint = BattleshipBoardGeneric::footprint(mSize);
+  footprint.initialCells = mInitialBoard.capacity();
+  footprint.currentCells = mBoard.capacity();
+  return footprint;
+}
+
+
+bool BattleshipBoardGeneric::isAlive() {
+  return mTargetsAvailable > 0;
+}
+
+
+BattleshipBoard::coordinate_t BattleshipBoardGeneric::getAvailableTarget() {
+  if (mNotAttackedSpotsRemaining == 0) {
+    return coordinate_t();
+  }
+
+  coordinate_t coordinate = randomCoordinate(mRng, mSize);
+  for (size_t i = 0;; ++i) {
+    UTL_assert(i < (mSize * mSize));
+    if (i >= (mSize * mSize)) {
+      throw("ERROR: Unable to find target, but mNotAttackedSpotsRemaining > 0.");
+    }
+    const char cell = mBoard[coordinate.index(mSize)];
+    if (cell == '_' || cell == 'O') {
+      break;
+    }
+    else if (coordinate.getRow() < (mSize - 1)) {
+      coordinate.setRow(coordinate.getRow() + 1);
+    }
+    else if (coordinate.getCol() < (mSize - 1)) {
+      coordinate.setRow(0);
+      coordinate.setCol(coordinate.getCol() + 1);
+    }
+    else {
+      coordinate.setRow(0);
+      coordinate.setCol(0);
+    }
+  }
+  return coordinate;
+}
+
+
+std::string BattleshipBoardGeneric::printCells(whichBoard board) {
+  std::string str = "";
+  const std::vector<char, BattleshipAllocator<char>> &cells = (board == INITIAL) ? mInitialBoard : mBoard;
+  for (size_t row = 0; row < mSize; ++row) {
+    str.append(cells.begin() + row * mSize, cells.begin() + (row + 1) * mSize);
+    str += "\n";
+  }
+  return str;
+}
+
+size_t BattleshipBoardGeneric::getRemainingTargets() {
+  return mTargetsAvailable;
+}
+
+BattleshipBoard::ATTACK_RESULT BattleshipBoardGeneric::attackLocation(coordinate_t &coordinate) {
+  char &cell = mBoard[coordinate.index(mSize)];
+  if (cell == '_') {
+    cell = '.';
+    mNotAttackedSpotsRemaining--;
+    markView(coordinate.index(mSize), 2);
+    return ATTACK_RESULT_INITIAL_MISS;
+  }
+  else if (cell == 'O') {
+    cell = '*';
+    mTargetsAvailable--;
+    mNotAttackedSpotsRemaining--;
+    markView(coordinate.index(mSize), 3);
+    return ATTACK_RESULT_INITIAL_HIT;
+  }
+  else if (cell == '.') {
+    return ATTACK_RESULT_SECONDARY_MISS;
+  }
+  else if (cell == '*') {
+    return ATTACK_RESULT_SECONDARY_HIT;
+  }
+  else {
+    return COUNT;
+  }
+}
+
+
+void BattleshipBoardGeneric::revive(size_t numberOfTargetsToAdd) {
+  for (size_t i = 0; i < numberOfTargetsToAdd; ++i) {
+    const size_t index = reviveIndex(mRng, mSize, [this](size_t aIndex) { return mBoard[aIndex] == 'O'; });
+    if (index == mSize * mSize) {
+      return;
+    }
+    if (mBoard[index] != '_') {
+      mNotAttackedSpotsRemaining++;
+    }
+    mBoard[index] = 'O';
+    markView(index, 1);
+    mTotalTargets++;
+    mTargetsAvailable++;
+  }
+}
@@ -0,0 +1,62 @@
+/**
+* @Filename: BattleshipBoardGeneric.hpp
+* @Author:   Ben Sokol <Ben>
+* @Email:    ben@bensokol.com
+* @Created:  October 18th, 2026 [4:40pm]
+* @Modified: October 18th, 2026 [8:50pm]
+* @Version:  1.0.0
+*
+* Copyright (C) 2019 by Ben Sokol. All Rights Reserved.
+*/
+
+#ifndef BATTLESHIPBOARDGENERIC_HPP
+#define BATTLESHIPBOARDGENERIC_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "BattleshipBoard.hpp"
+#include "BattleshipMemory.hpp"
+#include "BattleshipRandom.hpp"
+
+// A char per cell, for boards of any size
+class BattleshipBoardGeneric : public BattleshipBoard {
+public:
+  BattleshipBoardGeneric(size_t aSize, size_t aTotalTargets, uint64_t aSeed);
+  BattleshipBoardGeneric(size_t aSize,
+                         const state_t &aState,
+                         const uint8_t *aInitialCells,
+                         const uint8_t *aCurrentCells);
+  ~BattleshipBoardGeneric();
+
+  void saveState(state_t &aState, uint8_t *aInitialCells, uint8_t *aCurrentCells) const override;
+
+  static footprint_t footprint(size_t aSize);
+  footprint_t getFootprint() const override;
+
+  bool isAlive() override;
+
+  BattleshipBoard::coordinate_t getAvailableTarget() override;
+
+  size_t getRemainingTargets() override;
+
+  ATTACK_RESULT attackLocation(coordinate_t &coordinate) override;
+
+  void revive(size_t numberOfTargetsToAdd) override;
+
+protected:
+  std::string printCells(whichBoard board) override;
+
+private:
+  const size_t mSize;
+  size_t mTotalTargets;
+  size_t mTargetsAvailable;
+  size_t mNotAttackedSpotsRemaining;
+  // Row-major, one allocation per board
+  std::vector<char, BattleshipAllocator<char>> mInitialBoard;
+  std::vector<char, BattleshipAllocator<char>> mBoard;
+  BattleshipRandom mRng;
+};
+
+#endif
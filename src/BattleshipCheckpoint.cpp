@@ -0,0 +1,191 @@
+/**
+* @Filename: BattleshipCheckpoint.cpp
+* @Author:   Ben Sokol <Ben>
+* @Email:    ben@bensokol.com
+* @Created:  October 18th, 2026 [11:52am]
+* @Modified: October 19th, 2026 [1:45am]
+* @Version:  1.0.0
+*
+* Copyright (C) 2019 by Ben Sokol. All Rights Reserved.
+*/
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "UTL_assert.h"
+
+#include "BattleshipCheckpoint.hpp"
+
+static const char MAGIC[8] = { 'B', 'S', 'H', 'I', 'P', 'C', 'K', '\0' };
+
+
+BattleshipCheckpoint::BattleshipCheckpoint() : mData(nullptr), mLength(0), mMapped(false) {}
+
+
+BattleshipCheckpoint::BattleshipCheckpoint(size_t aPlayers, size_t aSize, size_t aTargets, uint64_t aSeed)
+    : mData(nullptr), mLength(sizeof(header_t) + aPlayers * recordSize(aSize)), mMapped(false) {
+  mBuffer = std::vector<uint64_t>(mLength / sizeof(uint64_t), 0);
+  mData = reinterpret_cast<char *>(mBuffer.data());
+
+  header_t header;
+  std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+  header.version = VERSION;
+  header.headerSize = sizeof(header_t);
+  header.players = aPlayers;
+  header.size = aSize;
+  header.targets = aTargets;
+  header.seed = aSeed;
+  header.sequence = 0;
+  header.recordSize = recordSize(aSize);
+  header.revives = 0;
+  std::memcpy(mData, &header, sizeof(header));
+}
+
+
+BattleshipCheckpoint::~BattleshipCheckpoint() {
+  if (mMapped) {
+    munmap(mData, mLength);
+  }
+}
+
+
+size_t BattleshipCheckpoint::recordSize(size_t aSize) {
+  const size_t bytes = sizeof(record_t) + 2 * BattleshipBoard::packedCellBytes(aSize);
+  return (bytes + sizeof(uint64_t) - 1) / sizeof(uint64_t) * sizeof(uint64_t);
+}
+
+
+/****************************************************************
+* load:
+*   Maps a checkpoint read only. Records are decoded in place, so
+*   loading costs one page fault per page actually touched.
+****************************************************************/
+std::unique_ptr<BattleshipCheckpoint> BattleshipCheckpoint::load(const std::string &aFile, std::string &aError) {
+  const int fd = open(aFile.c_str(), O_RDONLY);
+  if (fd == -1) {
+    aError = "Unable to open checkpoint " + aFile;
+    return nullptr;
+  }
+
+  struct stat info;
+  if (fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(header_t)) {
+    close(fd);
+    aError = "Checkpoint " + aFile + " is truncated";
+    return nullptr;
+  }
+
+  void *data = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (data == MAP_FAILED) {
+    aError = "Unable to map checkpoint " + aFile;
+    return nullptr;
+  }
+
+  std::unique_ptr<BattleshipCheckpoint> checkpoint(new BattleshipCheckpoint());
+  checkpoint->mData = static_cast<char *>(data);
+  checkpoint->mLength = static_cast<size_t>(info.st_size);
+  checkpoint->mMapped = true;
+
+  const header_t &header = checkpoint->getHeader();
+  if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0) {
+    aError = aFile + " is not a checkpoint";
+    return nullptr;
+  }
+  if (header.version != VERSION || header.headerSize != sizeof(header_t)) {
+    aError = "Checkpoint " + aFile + " was written by an incompatible version";
+    return nullptr;
+  }
+
+  // The header is read from disk, so P, N and M get the command line's limits before anything is sized from them
+  if (header.players < 2 || header.size == 0 || header.size > BattleshipBoard::coordinate_t::MAX_LINES
+      || header.targets == 0 || header.targets > header.size * header.size) {
+    aError = "Checkpoint " + aFile + " is corrupt, P, N or M is out of range";
+    return nullptr;
+  }
+  if (header.recordSize != recordSize(header.size)) {
+    aError = "Checkpoint " + aFile + " was written by an incompatible version";
+    return nullptr;
+  }
+
+  // Divided rather than multiplied, so a huge player count can not wrap around to the file's length
+  const size_t records = checkpoint->mLength - sizeof(header_t);
+  if (records % header.recordSize != 0 || records / header.recordSize != header.players) {
+    aError = "Checkpoint " + aFile + " is truncated";
+    return nullptr;
+  }
+  return checkpoint;
+}
+
+
+void BattleshipCheckpoint::setRevives(uint64_t aRevives) {
+  UTL_assert(!mMapped);
+  reinterpret_cast<header_t *>(mData)->revives = aRevives;
+}
+
+
+/****************************************************************
+* write:
+*   Writes to a temporary file and renames it over aFile, so a
+*   crash mid write never destroys the previous checkpoint.
+****************************************************************/
+bool BattleshipCheckpoint::write(const std::string &aFile, uint64_t aSequence) {
+  UTL_assert(!mMapped);
+  reinterpret_cast<header_t *>(mData)->sequence = aSequence;
+
+  const std::string temporary = aFile + ".tmp";
+  std::ofstream file(temporary, std::ofstream::out | std::ofstream::binary | std::ofstream::trunc);
+  if (!file.is_open()) {
+    return false;
+  }
+  file.write(mData, static_cast<std::streamsize>(mLength));
+  file.close();
+  if (file.fail()) {
+    std::remove(temporary.c_str());
+    return false;
+  }
+  return std::rename(temporary.c_str(), aFile.c_str()) == 0;
+}
+
+
+char *BattleshipCheckpoint::getRecordData(size_t aPlayerNum) const {
+  UTL_assert(aPlayerNum < getHeader().players);
+  return mData + sizeof(header_t) + aPlayerNum * getHeader().recordSize;
+}
+
+const BattleshipCheckpoint::header_t &BattleshipCheckpoint::getHeader() const {
+  return *reinterpret_cast<const header_t *>(mData);
+}
+
+const BattleshipCheckpoint::record_t &BattleshipCheckpoint::getRecord(size_t aPlayerNum) const {
+  return *reinterpret_cast<const record_t *>(getRecordData(aPlayerNum));
+}
+
+const uint8_t *BattleshipCheckpoint::getInitialCells(size_t aPlayerNum) const {
+  return reinterpret_cast<const uint8_t *>(getRecordData(aPlayerNum) + sizeof(record_t));
+}
+
+const uint8_t *BattleshipCheckpoint::getCurrentCells(size_t aPlayerNum) const {
+  return getInitialCells(aPlayerNum) + BattleshipBoard::packedCellBytes(getHeader().size);
+}
+
+BattleshipCheckpoint::record_t &BattleshipCheckpoint::getRecord(size_t aPlayerNum) {
+  UTL_assert(!mMapped);
+  return *reinterpret_cast<record_t *>(getRecordData(aPlayerNum));
+}
+
+uint8_t *BattleshipCheckpoint::getInitialCells(size_t aPlayerNum) {
+  UTL_assert(!mMapped);
+  return reinterpret_cast<uint8_t *>(getRecordData(aPlayerNum) + sizeof(record_t));
+}
+
+uint8_t *BattleshipCheckpoint::getCurrentCells(size_t aPlayerNum) {
+  return getInitialCells(aPlayerNum) + BattleshipBoard::packedCellBytes(getHeader().size);
+}
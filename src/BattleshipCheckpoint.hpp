@@ -0,0 +1,76 @@
+/**
+* @Filename: BattleshipCheckpoint.hpp
+* @Author:   Ben Sokol <Ben>
+* @Email:    ben@bensokol.com
+* @Created:  October 18th, 2026 [11:52am]
+* @Modified: October 19th, 2026 [1:45am]
+* @Version:  1.0.0
+*
+* Copyright (C) 2019 by Ben Sokol. All Rights Reserved.
+*/
+
+#ifndef BATTLESHIPCHECKPOINT_HPP
+#define BATTLESHIPCHECKPOINT_HPP
+
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "BattleshipPlayer.hpp"
+
+// File layout: header_t, then one fixed size record per player. A record is a record_t followed by the initial and
+// current cells packed 2 bits each, padded to 8 bytes. Integers are stored in host byte order, VERSION changes
+// whenever the layout does.
+class BattleshipCheckpoint {
+public:
+  static const uint32_t VERSION = 2;
+
+  struct header_t {
+    char magic[8];
+    uint32_t version;
+    uint32_t headerSize;
+    uint64_t players;
+    uint64_t size;
+    uint64_t targets;
+    uint64_t seed;
+    uint64_t sequence;
+    uint64_t recordSize;
+    uint64_t revives;  // revives made in the battle so far
+  };
+
+  struct record_t {
+    BattleshipPlayer::state_t player;
+    uint64_t battleRngState;
+  };
+
+  BattleshipCheckpoint(size_t aPlayers, size_t aSize, size_t aTargets, uint64_t aSeed);
+  ~BattleshipCheckpoint();
+
+  static std::unique_ptr<BattleshipCheckpoint> load(const std::string &aFile, std::string &aError);
+
+  const header_t &getHeader() const;
+  const record_t &getRecord(size_t aPlayerNum) const;
+  const uint8_t *getInitialCells(size_t aPlayerNum) const;
+  const uint8_t *getCurrentCells(size_t aPlayerNum) const;
+  record_t &getRecord(size_t aPlayerNum);
+  uint8_t *getInitialCells(size_t aPlayerNum);
+  uint8_t *getCurrentCells(size_t aPlayerNum);
+
+  void setRevives(uint64_t aRevives);
+  bool write(const std::string &aFile, uint64_t aSequence);
+
+private:
+  BattleshipCheckpoint();
+
+  static size_t recordSize(size_t aSize);
+  char *getRecordData(size_t aPlayerNum) const;
+
+  char *mData;
+  size_t mLength;
+  bool mMapped;
+  std::vector<uint64_t> mBuffer;
+};
+
+#endif
@@ -0,0 +1,156 @@
+/**
+* @Filename: BattleshipCounters.cpp
+* @Author:   Ben Sokol <Ben>
+* @Email:    ben@bensokol.com
+* @Created:  October 18th, 2026 [3:12pm]
+* @Modified: October 18th, 2026 [3:12pm]
+* @Version:  1.0.0
+*
+* Copyright (C) 2019 by Ben Sokol. All Rights Reserved.
+*/
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#ifdef __linux__
+#include <cerrno>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "BattleshipCounters.hpp"
+
+
+namespace {
+#ifdef __linux__
+  const struct {
+    uint32_t type;
+    uint64_t config;
+  } EVENTS[BattleshipCounters::COUNTER_COUNT] = {
+    { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },     { PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+    { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES },   { PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES },
+    { PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CONTEXT_SWITCHES }
+  };
+#endif
+
+  const char *NAMES[BattleshipCounters::COUNTER_COUNT] = { "Cycles", "Instructions", "Cache Misses", "Branch Misses",
+                                                           "Context Switches" };
+}  // namespace
+
+
+BattleshipCounters::sample_t &BattleshipCounters::sample_t::operator+=(const sample_t &aSample) {
+  for (size_t i = 0; i < COUNTER_COUNT; ++i) {
+    if (aSample.valid[i]) {
+      value[i] += aSample.value[i];
+      valid[i] = true;
+    }
+  }
+  return *this;
+}
+
+
+BattleshipCounters::BattleshipCounters() {
+  for (size_t i = 0; i < COUNTER_COUNT; ++i) {
+    mFds[i] = -1;
+  }
+
+#ifdef __linux__
+  for (size_t i = 0; i < COUNTER_COUNT; ++i) {
+    struct perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = EVENTS[i].type;
+    attr.config = EVENTS[i].config;
+    attr.disabled = 1;
+    attr.exclude_hv = 1;
+
+    // Context switches happen in the kernel. Everything else falls back to user space only, which
+    // perf_event_paranoid=2 still allows.
+    attr.exclude_kernel = (i != CONTEXT_SWITCHES);
+    mFds[i] = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+    if (mFds[i] < 0 && !attr.exclude_kernel) {
+      attr.exclude_kernel = 1;
+      mFds[i] = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+    }
+    if (mFds[i] < 0 && mError.empty()) {
+      mError = std::string("perf_event_open failed (") + std::strerror(errno)
+               + "), see /proc/sys/kernel/perf_event_paranoid";
+    }
+  }
+#else
+  mError = "Hardware counters are only supported on Linux";
+#endif
+}
+
+
+BattleshipCounters::~BattleshipCounters() {
+#ifdef __linux__
+  for (size_t i = 0; i < COUNTER_COUNT; ++i) {
+    if (mFds[i] >= 0) {
+      close(mFds[i]);
+    }
+  }
+#endif
+}
+
+
+bool BattleshipCounters::isSupported() {
+#ifdef __linux__
+  return true;
+#else
+  return false;
+#endif
+}
+
+
+const char *BattleshipCounters::getName(size_t aCounter) {
+  return aCounter < COUNTER_COUNT ? NAMES[aCounter] : "";
+}
+
+
+bool BattleshipCounters::isOpen() const {
+  for (size_t i = 0; i < COUNTER_COUNT; ++i) {
+    if (mFds[i] >= 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+
+const std::string &BattleshipCounters::getError() const {
+  return mError;
+}
+
+
+void BattleshipCounters::start() {
+#ifdef __linux__
+  for (size_t i = 0; i < COUNTER_COUNT; ++i) {
+    if (mFds[i] >= 0) {
+      ioctl(mFds[i], PERF_EVENT_IOC_RESET, 0);
+      ioctl(mFds[i], PERF_EVENT_IOC_ENABLE, 0);
+    }
+  }
+#endif
+}
+
+
+BattleshipCounters::sample_t BattleshipCounters::stop() {
+  sample_t sample;
+#ifdef __linux__
+  for (size_t i = 0; i < COUNTER_COUNT; ++i) {
+    if (mFds[i] >= 0) {
+      ioctl(mFds[i], PERF_EVENT_IOC_DISABLE, 0);
+      uint64_t value = 0;
+      if (read(mFds[i], &value, sizeof(value)) == static_cast<ssize_t>(sizeof(value))) {
+        sample.value[i] = value;
+        sample.valid[i] = true;
+      }
+    }
+  }
+#endif
+  return sample;
+}
@@ -0,0 +1,51 @@
+/**
+* @Filename: BattleshipCounters.hpp
+* @Author:   Ben Sokol <Ben>
+* @Email:    ben@bensokol.com
+* @Created:  October 18th, 2026 [3:12pm]
+* @Modified: October 18th, 2026 [3:12pm]
+* @Version:  1.0.0
+*
+* Copyright (C) 2019 by Ben Sokol. All Rights Reserved.
+*/
+
+#ifndef BATTLESHIPCOUNTERS_HPP
+#define BATTLESHIPCOUNTERS_HPP
+
+#include <cstdint>
+#include <string>
+
+// Hardware counters of one thread, read through perf_event_open (Linux only). Each counter is opened on its own, so a
+// kernel or VM that refuses some of them still reports the rest.
+class BattleshipCounters {
+public:
+  enum COUNTER { CYCLES, INSTRUCTIONS, CACHE_MISSES, BRANCH_MISSES, CONTEXT_SWITCHES, COUNTER_COUNT };
+
+  struct sample_t {
+    uint64_t value[COUNTER_COUNT] = {};
+    bool valid[COUNTER_COUNT] = {};
+
+    sample_t &operator+=(const sample_t &aSample);
+  };
+
+  // Counts the calling thread, but may be started, stopped and read from any thread
+  BattleshipCounters();
+  ~BattleshipCounters();
+  BattleshipCounters(const BattleshipCounters &) = delete;
+  BattleshipCounters &operator=(const BattleshipCounters &) = delete;
+
+  static bool isSupported();
+  static const char *getName(size_t aCounter);
+
+  bool isOpen() const;
+  const std::string &getError() const;
+
+  void start();
+  sample_t stop();
+
+private:
+  int mFds[COUNTER_COUNT];
+  std::string mError;
+};
+
+#endif
@@ -0,0 +1,345 @@
+/**
+* @Filename: BattleshipGames.cpp
+* @Author:   Ben Sokol <Ben>
+* @Email:    ben@bensokol.com
+* @Created:  October 18th, 2026 [10:05pm]
+* @Modified: October 18th, 2026 [10:05pm]
+* @Version:  1.0.0
+*
+* Copyright (C) 2019 by Ben Sokol. All Rights Reserved.
+*/
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+
+#include "UTL_assert.h"
+
+#include "BattleshipGames.hpp"
+#include "BattleshipRandom.hpp"
+
+#define GAMES_INLINE inline __attribute__((always_inline))
+
+
+namespace {
+  const char *NAMES[BattleshipGames::WIDTH_COUNT] = { "scalar", "avx2", "avx512" };
+  const size_t LANES[BattleshipGames::WIDTH_COUNT] = { 1, 8, 16 };
+
+  // One uint64_t or double per game. GCC lowers each operation to as many registers as the width needs.
+  template <size_t COUNT>
+  struct lanes_t;
+
+  template <>
+  struct lanes_t<1> {
+    typedef uint64_t word_t __attribute__((vector_size(8)));
+    typedef double real_t __attribute__((vector_size(8)));
+  };
+
+  template <>
+  struct lanes_t<8> {
+    typedef uint64_t word_t __attribute__((vector_size(64)));
+    typedef double real_t __attribute__((vector_size(64)));
+  };
+
+  template <>
+  struct lanes_t<16> {
+    typedef uint64_t word_t __attribute__((vector_size(128)));
+    typedef double real_t __attribute__((vector_size(128)));
+  };
+
+  // Adding and subtracting 2^52 moves an integer below 2^52 in and out of a double's mantissa
+  const uint64_t EXPONENT_BITS = 0x4330000000000000ULL;
+  const uint64_t MANTISSA_BITS = 0xFFFFFFFFFFFFFULL;
+  const double TWO_POW_52 = 4503599627370496.0;
+
+  struct game_t {
+    size_t size;
+    size_t targets;
+    uint64_t validCells;  // bit col * 8 + row for every col, row < size
+    uint64_t divisor;     // size, for the scalar lanes
+    double inverse;       // 1 / size
+    double real;          // size
+    double pow32;         // 2^32 % size
+  };
+
+  // Helpers take and return vectors by reference, vectors wider than the default target may not cross a call
+  template <size_t COUNT>
+  GAMES_INLINE void nextRandom(typename lanes_t<COUNT>::word_t &aState,
+                               const typename lanes_t<COUNT>::word_t &aStep,
+                               typename lanes_t<COUNT>::word_t &aValue) {
+    aState += aStep;
+    aValue = aState;
+    aValue = (aValue ^ (aValue >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    aValue = (aValue ^ (aValue >> 27)) * 0x94d049bb133111ebULL;
+    aValue = aValue ^ (aValue >> 31);
+  }
+
+  /****************************************************************
+  * reduce:
+  *   aValue % size. Vector units have no 64 bit division, but the
+  *   value is exact as a double once split into 32 bit halves, and
+  *   the fraction of value / size is a multiple of 1 / size, so the
+  *   quotient rounds correctly from 0.4375 below it for size <= 8.
+  ****************************************************************/
+  template <size_t COUNT>
+  GAMES_INLINE void reduce(typename lanes_t<COUNT>::word_t &aValue, const game_t &aGame) {
+    typedef typename lanes_t<COUNT>::word_t word_t;
+    typedef typename lanes_t<COUNT>::real_t real_t;
+
+    if constexpr (COUNT == 1) {
+      aValue[0] %= aGame.divisor;
+    }
+    else {
+      const word_t high = (aValue >> 32) | EXPONENT_BITS;
+      const word_t low = (aValue & 0xFFFFFFFFULL) | EXPONENT_BITS;
+      const real_t value = ((real_t)high - TWO_POW_52) * aGame.pow32 + ((real_t)low - TWO_POW_52);
+      const real_t quotient = ((value * aGame.inverse - 0.4375) + TWO_POW_52) - TWO_POW_52;
+      aValue = (word_t)((value - quotient * aGame.real) + TWO_POW_52) & MANTISSA_BITS;
+    }
+  }
+
+  // randomCoordinate, as the bit it starts from
+  template <size_t COUNT>
+  GAMES_INLINE void randomStart(typename lanes_t<COUNT>::word_t &aRng,
+                                const typename lanes_t<COUNT>::word_t &aStep,
+                                const game_t &aGame,
+                                typename lanes_t<COUNT>::word_t &aStart) {
+    typename lanes_t<COUNT>::word_t col;
+    typename lanes_t<COUNT>::word_t row;
+    nextRandom<COUNT>(aRng, aStep, col);
+    nextRandom<COUNT>(aRng, aStep, row);
+    reduce<COUNT>(col, aGame);
+    reduce<COUNT>(row, aGame);
+    aStart = (col << 3) | row;
+  }
+
+  // All ones in the lanes where aWord is not zero. A vector comparison is split up into one compare per lane by GCC
+  // when the vector is wider than a register, this is three operations on whole registers.
+  template <size_t COUNT>
+  GAMES_INLINE void nonZero(const typename lanes_t<COUNT>::word_t &aWord, typename lanes_t<COUNT>::word_t &aMask) {
+    aMask = -((aWord | -aWord) >> 63);
+  }
+
+  // findFrom: bits in order are cells down each column, so the first free cell at or after aStart is the lowest set
+  // bit above it, or the lowest set bit overall once the search wraps
+  template <size_t COUNT>
+  GAMES_INLINE void findFrom(const typename lanes_t<COUNT>::word_t &aFree,
+                             const typename lanes_t<COUNT>::word_t &aStart,
+                             typename lanes_t<COUNT>::word_t &aCell) {
+    typedef typename lanes_t<COUNT>::word_t word_t;
+    const word_t none = {};
+    const word_t after = aFree & (~none << aStart);
+    word_t found;
+    nonZero<COUNT>(after, found);
+    const word_t candidates = after | (aFree & ~found);
+    aCell = candidates & -candidates;
+  }
+
+  template <size_t COUNT>
+  GAMES_INLINE bool anyLane(const typename lanes_t<COUNT>::word_t &aWord) {
+    uint64_t any = 0;
+    for (size_t lane = 0; lane < COUNT; ++lane) {
+      any |= aWord[lane];
+    }
+    return any != 0;
+  }
+
+
+  /****************************************************************
+  * playLanes:
+  *   Up to COUNT games side by side, each ending when a board is
+  *   sunk. As in battleSequential, player 0 attacks then player 1,
+  *   and each cell is drawn from the generator of the board being
+  *   attacked. The battle generators only pick the opponent, which
+  *   for two players is always the other, so they are not kept.
+  ****************************************************************/
+  template <size_t COUNT>
+  GAMES_INLINE void playLanes(const game_t &aGame,
+                              uint64_t aFirstSeed,
+                              uint64_t aCount,
+                              BattleshipGames::result_t &aResult) {
+    typedef typename lanes_t<COUNT>::word_t word_t;
+    const word_t none = {};
+    const word_t all = ~none;
+    const word_t step = all & 0x9e3779b97f4a7c15ULL;
+
+    word_t rngs[2] = { none, none };
+    word_t ships[2] = { none, none };
+    word_t attacked[2] = { none, none };
+    word_t remaining[2] = { none + aGame.targets, none + aGame.targets };
+    word_t active = none;
+    for (size_t lane = 0; lane < COUNT; ++lane) {
+      rngs[0][lane] = BattleshipRandom::hash(aFirstSeed + lane, 0);
+      rngs[1][lane] = BattleshipRandom::hash(aFirstSeed + lane, 2);
+      active[lane] = lane < aCount ? ~uint64_t(0) : 0;
+    }
+
+    word_t start;
+    word_t cell;
+    for (size_t board = 0; board < 2; ++board) {
+      for (size_t i = 0; i < aGame.targets; ++i) {
+        randomStart<COUNT>(rngs[board], step, aGame, start);
+        findFrom<COUNT>(~ships[board] & aGame.validCells, start, cell);
+        ships[board] |= cell;
+      }
+    }
+
+    // Finished lanes keep running, masked so their boards, generators and tallies stay as they are
+    word_t attacks[2] = { none, none };
+    word_t hits[2] = { none, none };
+    word_t wins[2] = { none, none };
+    while (anyLane<COUNT>(active)) {
+      for (size_t player = 0; player < 2; ++player) {
+        const size_t target = 1 - player;
+        randomStart<COUNT>(rngs[target], step & active, aGame, start);
+        findFrom<COUNT>(~attacked[target] & aGame.validCells, start, cell);
+        cell &= active;
+
+        word_t hit;
+        nonZero<COUNT>(ships[target] & cell, hit);
+        attacked[target] |= cell;
+        remaining[target] += hit;
+        attacks[player] += active & 1;
+        hits[player] -= hit;
+
+        word_t afloat;
+        nonZero<COUNT>(remaining[target], afloat);
+        const word_t sunk = active & ~afloat;
+        wins[player] -= sunk;
+        active &= ~sunk;
+      }
+    }
+
+    aResult.games += aCount;
+    for (size_t lane = 0; lane < COUNT; ++lane) {
+      for (size_t player = 0; player < 2; ++player) {
+        aResult.wins[player] += wins[player][lane];
+        aResult.attacks[player] += attacks[player][lane];
+        aResult.hits[player] += hits[player][lane];
+      }
+    }
+  }
+
+
+  template <size_t COUNT>
+  GAMES_INLINE void playAll(const game_t &aGame,
+                            uint64_t aFirstSeed,
+                            uint64_t aCount,
+                            BattleshipGames::result_t &aResult) {
+    for (uint64_t played = 0; played < aCount; played += COUNT) {
+      playLanes<COUNT>(aGame, aFirstSeed + played, std::min<uint64_t>(COUNT, aCount - played), aResult);
+    }
+  }
+
+
+  void playScalar(const game_t &aGame, uint64_t aFirstSeed, uint64_t aCount, BattleshipGames::result_t &aResult) {
+    playAll<1>(aGame, aFirstSeed, aCount, aResult);
+  }
+
+#if defined(__x86_64__)
+  // Compiled for the wider units whatever the build targets, and only called once detect has seen them
+  __attribute__((target("avx2,bmi2"))) void playAvx2(const game_t &aGame,
+                                                     uint64_t aFirstSeed,
+                                                     uint64_t aCount,
+                                                     BattleshipGames::result_t &aResult) {
+    playAll<8>(aGame, aFirstSeed, aCount, aResult);
+  }
+
+  __attribute__((target("avx512f,avx512dq,avx512vl"))) void playAvx512(const game_t &aGame,
+                                                                       uint64_t aFirstSeed,
+                                                                       uint64_t aCount,
+                                                                       BattleshipGames::result_t &aResult) {
+    playAll<16>(aGame, aFirstSeed, aCount, aResult);
+  }
+#endif
+}  // namespace
+
+
+BattleshipGames::result_t &BattleshipGames::result_t::operator+=(const result_t &aResult) {
+  games += aResult.games;
+  for (size_t i = 0; i < 2; ++i) {
+    wins[i] += aResult.wins[i];
+    attacks[i] += aResult.attacks[i];
+    hits[i] += aResult.hits[i];
+  }
+  return *this;
+}
+
+
+BattleshipGames::WIDTH BattleshipGames::detect() {
+  if (isSupported(WIDTH_AVX512)) {
+    return WIDTH_AVX512;
+  }
+  else if (isSupported(WIDTH_AVX2)) {
+    return WIDTH_AVX2;
+  }
+  return WIDTH_SCALAR;
+}
+
+
+bool BattleshipGames::isSupported(WIDTH aWidth) {
+#if defined(__x86_64__)
+  __builtin_cpu_init();
+  switch (aWidth) {
+    case WIDTH_SCALAR:
+      return true;
+    case WIDTH_AVX2:
+      return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("bmi2");
+    case WIDTH_AVX512:
+      return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512dq")
+             && __builtin_cpu_supports("avx512vl");
+    default:
+      return false;
+  }
+#else
+  return aWidth == WIDTH_SCALAR;
+#endif
+}
+
+
+const char *BattleshipGames::getName(WIDTH aWidth) {
+  return aWidth < WIDTH_COUNT ? NAMES[aWidth] : "unknown";
+}
+
+
+size_t BattleshipGames::getLanes(WIDTH aWidth) {
+  return aWidth < WIDTH_COUNT ? LANES[aWidth] : 0;
+}
+
+
+void BattleshipGames::play(WIDTH aWidth,
+                           size_t aSize,
+                           size_t aTargets,
+                           uint64_t aFirstSeed,
+                           uint64_t aCount,
+                           result_t &aResult) {
+  UTL_assert(aSize > 0 && aSize <= MAX_SIZE);
+  UTL_assert(aTargets > 0 && aTargets <= aSize * aSize);
+  UTL_assert(isSupported(aWidth));
+
+  game_t game;
+  game.size = aSize;
+  game.targets = aTargets;
+  game.validCells = 0;
+  for (size_t col = 0; col < aSize; ++col) {
+    game.validCells |= ((uint64_t(1) << aSize) - 1) << (col * 8);
+  }
+  game.divisor = aSize;
+  game.inverse = 1.0 / static_cast<double>(aSize);
+  game.real = static_cast<double>(aSize);
+  game.pow32 = static_cast<double>((uint64_t(1) << 32) % aSize);
+
+  switch (aWidth) {
+#if defined(__x86_64__)
+    case WIDTH_AVX512:
+      playAvx512(game, aFirstSeed, aCount, aResult);
+      break;
+    case WIDTH_AVX2:
+      playAvx2(game, aFirstSeed, aCount, aResult);
+      break;
+#endif
+    default:
+      playScalar(game, aFirstSeed, aCount, aResult);
+      break;
+  }
+}
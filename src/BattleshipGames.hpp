@@ -0,0 +1,57 @@
+/**
+* @Filename: BattleshipGames.hpp
+* @Author:   Ben Sokol <Ben>
+* @Email:    ben@bensokol.com
+* @Created:  October 18th, 2026 [10:05pm]
+* @Modified: October 18th, 2026 [10:05pm]
+* @Version:  1.0.0
+*
+* Copyright (C) 2019 by Ben Sokol. All Rights Reserved.
+*/
+
+#ifndef BATTLESHIPGAMES_HPP
+#define BATTLESHIPGAMES_HPP
+
+#include <cstdint>
+#include <cstdlib>
+
+// Many independent two-player games on boards of up to 8x8, one game per vector lane. A board is one word with bit
+// col * 8 + row per cell, the layout of BattleshipBitBoard<8> with its columns concatenated, so finding the next free
+// cell, attacking it and checking for a hit are a handful of word operations for every lane at once. Each game is the
+// game ./battleship 2 N M --seed=S --engine=sequential would play, random draws included.
+class BattleshipGames {
+public:
+  enum WIDTH {
+    WIDTH_SCALAR,  // 1 game at a time
+    WIDTH_AVX2,    // 8 games, in two 256 bit registers per word
+    WIDTH_AVX512,  // 16 games, in two 512 bit registers per word
+    WIDTH_COUNT
+  };
+
+  struct result_t {
+    uint64_t games = 0;
+    uint64_t wins[2] = {};
+    uint64_t attacks[2] = {};  // launched by each player
+    uint64_t hits[2] = {};
+
+    result_t &operator+=(const result_t &aResult);
+  };
+
+  static const size_t MAX_SIZE = 8;
+
+  // The widest the CPU supports, x86-64 only
+  static WIDTH detect();
+  static bool isSupported(WIDTH aWidth);
+  static const char *getName(WIDTH aWidth);
+  static size_t getLanes(WIDTH aWidth);
+
+  // Plays the games seeded aFirstSeed to aFirstSeed + aCount - 1 and adds them to aResult
+  static void play(WIDTH aWidth,
+                   size_t aSize,
+                   size_t aTargets,
+                   uint64_t aFirstSeed,
+                   uint64_t aCount,
+                   result_t &aResult);
+};
+
+#endif
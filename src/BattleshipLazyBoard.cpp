@@ -0,0 +1,249 @@
+/**
+* @Filename: BattleshipLazyBoard.cpp
+* @Author:   Ben Sokol <Ben>
+* @Email:    ben@bensokol.com
+* @Created:  October 18th, 2026 [10:30pm]
+* @Modified: October 19th, 2026 [2:05am]
+* @Version:  1.0.0
+*
+* Copyright (C) 2019 by Ben Sokol. All Rights Reserved.
+*/
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "UTL_assert.h"
+
+#include "BattleshipAllocations.hpp"
+#include "BattleshipLazyBoard.hpp"
+
+
+namespace {
+  const size_t FEISTEL_ROUNDS = 4;
+  const size_t MIN_TOUCHED_SLOTS = 16;
+}  // namespace
+
+
+BattleshipLazyBoard::BattleshipLazyBoard(size_t aSize, size_t aTotalTargets, uint64_t aSeed)
+    : mSize(aSize),
+      mCells(aSize * aSize),
+      mInitialTargets(aTotalTargets),
+      mTotalTargets(aTotalTargets),
+      mTargetsAvailable(aTotalTargets),
+      mNotAttackedSpotsRemaining(aSize * aSize),
+      mKey(BattleshipRandom::hash(aSeed, 1)),
+      mHalfBits(1),
+      mTouched(),
+      mTouchedCount(0),
+      mRng(aSeed) {
+  UTL_assert(mSize <= MAX_LINES && mTotalTargets <= mCells);
+  while ((uint64_t(1) << (2 * mHalfBits)) < mCells) {
+    mHalfBits++;
+  }
+}
+
+
+BattleshipLazyBoard::~BattleshipLazyBoard() {}
+
+
+void BattleshipLazyBoard::saveState(state_t &aState, uint8_t *aInitialCells, uint8_t *aCurrentCells) const {
+  aState.totalTargets = mTotalTargets;
+  aState.targetsAvailable = mTargetsAvailable;
+  aState.notAttackedSpotsRemaining = mNotAttackedSpotsRemaining;
+  aState.rngState = mRng.getState();
+
+  std::fill(aInitialCells, aInitialCells + packedCellBytes(mSize), 0);
+  std::fill(aCurrentCells, aCurrentCells + packedCellBytes(mSize), 0);
+  for (size_t i = 0; i < mCells; ++i) {
+    const size_t shift = (i % 4) * 2;
+    aInitialCells[i / 4] |= static_cast<uint8_t>(initialCode(i) << shift);
+    aCurrentCells[i / 4] |= static_cast<uint8_t>(currentCode(i) << shift);
+  }
+}
+
+
+BattleshipBoard::footprint_t BattleshipLazyBoard::footprint(size_t) {
+  footprint_t footprint;
+  footprint.initialCells = 0;
+  footprint.currentCells = 0;
+  footprint.overhead = sizeof(BattleshipLazyBoard);
+  return footprint;
+}
+
+
+BattleshipBoard::footprint_t BattleshipLazyBoard::getFootprint() const {
+  footprint_t footprint = BattleshipLazyBoard::footprint(mSize);
+  footprint.currentCells = mTouched.capacity() * sizeof(uint32_t);
+  return footprint;
+}
+
+
+bool BattleshipLazyBoard::isAlive() {
+  return mTargetsAvailable > 0;
+}
+
+
+/****************************************************************
+* getAvailableTarget:
+*   The same walk as BattleshipBoardGeneric, down each column from
+*   a random cell. Untouched cells are never in the table, so most
+*   steps are a single probe.
+****************************************************************/
+BattleshipBoard::coordinate_t BattleshipLazyBoard::getAvailableTarget() {
+  if (mNotAttackedSpotsRemaining == 0) {
+    return coordinate_t();
+  }
+
+  coordinate_t coordinate = randomCoordinate(mRng, mSize);
+  for (size_t i = 0;; ++i) {
+    UTL_assert(i < mCells);
+    if (i >= mCells) {
+      throw("ERROR: Unable to find target, but mNotAttackedSpotsRemaining > 0.");
+    }
+    if ((currentCode(coordinate.index(mSize)) & 2) == 0) {
+      break;
+    }
+    else if (coordinate.getRow() < (mSize - 1)) {
+      coordinate.setRow(coordinate.getRow() + 1);
+    }
+    else if (coordinate.getCol() < (mSize - 1)) {
+      coordinate.setRow(0);
+      coordinate.setCol(coordinate.getCol() + 1);
+    }
+    else {
+      coordinate.setRow(0);
+      coordinate.setCol(0);
+    }
+  }
+  return coordinate;
+}
+
+
+size_t BattleshipLazyBoard::getRemainingTargets() {
+  return mTargetsAvailable;
+}
+
+
+BattleshipBoard::ATTACK_RESULT BattleshipLazyBoard::attackLocation(coordinate_t &coordinate) {
+  const size_t index = coordinate.index(mSize);
+  const uint8_t code = currentCode(index);
+  if ((code & 2) != 0) {
+    return (code & 1) ? ATTACK_RESULT_SECONDARY_HIT : ATTACK_RESULT_SECONDARY_MISS;
+  }
+
+  setCode(index, code | 2);
+  markView(index, code | 2);
+  mNotAttackedSpotsRemaining--;
+  if (code & 1) {
+    mTargetsAvailable--;
+    return ATTACK_RESULT_INITIAL_HIT;
+  }
+  return ATTACK_RESULT_INITIAL_MISS;
+}
+
+
+void BattleshipLazyBoard::revive(size_t numberOfTargetsToAdd) {
+  for (size_t i = 0; i < numberOfTargetsToAdd; ++i) {
+    const size_t index = reviveIndex(mRng, mSize, [this](size_t aIndex) { return currentCode(aIndex) == 1; });
+    if (index == mCells) {
+      return;
+    }
+    if ((currentCode(index) & 2) != 0) {
+      mNotAttackedSpotsRemaining++;
+    }
+    setCode(index, 1);
+    markView(index, 1);
+    mTotalTargets++;
+    mTargetsAvailable++;
+  }
+}
+
+
+std::string BattleshipLazyBoard::printCells(whichBoard board) {
+  std::string str = "";
+  for (size_t row = 0; row < mSize; ++row) {
+    for (size_t col = 0; col < mSize; ++col) {
+      const size_t index = row * mSize + col;
+      str += cellOfCode(board == INITIAL ? initialCode(index) : currentCode(index));
+    }
+    str += "\n";
+  }
+  return str;
+}
+
+
+/****************************************************************
+* permute:
+*   A keyed bijection on [0, mCells). The Feistel network permutes
+*   [0, 4^mHalfBits), at most 4 times mCells, and indices past the
+*   board are walked until they land on it.
+****************************************************************/
+size_t BattleshipLazyBoard::permute(size_t aIndex) const {
+  const uint64_t mask = (uint64_t(1) << mHalfBits) - 1;
+  uint64_t value = aIndex;
+  do {
+    uint64_t left = value >> mHalfBits;
+    uint64_t right = value & mask;
+    for (size_t round = 0; round < FEISTEL_ROUNDS; ++round) {
+      const uint64_t next = left ^ (BattleshipRandom::hash(mKey + round, right) & mask);
+      left = right;
+      right = next;
+    }
+    value = (left << mHalfBits) | right;
+  } while (value >= mCells);
+  return static_cast<size_t>(value);
+}
+
+
+uint8_t BattleshipLazyBoard::initialCode(size_t aIndex) const {
+  return permute(aIndex) < mInitialTargets ? 1 : 0;
+}
+
+
+uint8_t BattleshipLazyBoard::currentCode(size_t aIndex) const {
+  if (mTouchedCount > 0) {
+    const uint32_t slot = mTouched[slotOf(aIndex)];
+    if (slot != 0) {
+      return static_cast<uint8_t>(slot & 3);
+    }
+  }
+  return initialCode(aIndex);
+}
+
+
+void BattleshipLazyBoard::setCode(size_t aIndex, uint8_t aCode) {
+  // The table grows with the attacks for the whole battle, lazy boards are exempt from allocation free turns
+  if ((mTouchedCount + 1) * 2 > mTouched.size()) {
+    BattleshipAllocations::Allow allow;
+    grow();
+  }
+  uint32_t &slot = mTouched[slotOf(aIndex)];
+  if (slot == 0) {
+    mTouchedCount++;
+  }
+  slot = static_cast<uint32_t>(((aIndex + 1) << 2) | aCode);
+}
+
+
+// Linear probing from a multiplicative hash, the table is a power of two and at most half full
+size_t BattleshipLazyBoard::slotOf(size_t aIndex) const {
+  const size_t mask = mTouched.size() - 1;
+  size_t slot = static_cast<size_t>((aIndex * 0x9e3779b97f4a7c15ULL) >> (64 - __builtin_ctzll(mTouched.size())));
+  while (mTouched[slot] != 0 && (mTouched[slot] >> 2) != aIndex + 1) {
+    slot = (slot + 1) & mask;
+  }
+  return slot;
+}
+
+
+void BattleshipLazyBoard::grow() {
+  std::vector<uint32_t> touched(std::max(MIN_TOUCHED_SLOTS, mTouched.size() * 2), 0);
+  touched.swap(mTouched);
+  for (uint32_t slot : touched) {
+    if (slot != 0) {
+      mTouched[slotOf((slot >> 2) - 1)] = slot;
+    }
+  }
+}
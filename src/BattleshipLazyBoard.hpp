@@ -0,0 +1,78 @@
+/**
+* @Filename: BattleshipLazyBoard.hpp
+* @Author:   Ben Sokol <Ben>
+* @Email:    ben@bensokol.com
+* @Created:  October 18th, 2026 [10:30pm]
+* @Modified: October 19th, 2026 [1:20am]
+* @Version:  1.0.0
+*
+* Copyright (C) 2019 by Ben Sokol. All Rights Reserved.
+*/
+
+#ifndef BATTLESHIPLAZYBOARD_HPP
+#define BATTLESHIPLAZYBOARD_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "BattleshipBoard.hpp"
+#include "BattleshipRandom.hpp"
+
+// A board that only stores the cells it has touched. Cell i starts as a target if a keyed permutation of the N²
+// cells maps it below M, so exactly M cells are targets and nothing is placed or allocated by the constructor. Every
+// attacked or revived cell is kept in an open addressing table, which grows with the number of attacks.
+class BattleshipLazyBoard : public BattleshipBoard {
+public:
+  // A slot holds a cell index and its code in 32 bits
+  static const size_t MAX_LINES = 32767;
+
+  BattleshipLazyBoard(size_t aSize, size_t aTotalTargets, uint64_t aSeed);
+  ~BattleshipLazyBoard();
+
+  // Writes every cell, a resumed battle stores them in a regular board
+  void saveState(state_t &aState, uint8_t *aInitialCells, uint8_t *aCurrentCells) const override;
+
+  static footprint_t footprint(size_t aSize);
+  footprint_t getFootprint() const override;
+
+  bool isAlive() override;
+
+  BattleshipBoard::coordinate_t getAvailableTarget() override;
+
+  size_t getRemainingTargets() override;
+
+  ATTACK_RESULT attackLocation(coordinate_t &coordinate) override;
+
+  void revive(size_t numberOfTargetsToAdd) override;
+
+protected:
+  std::string printCells(whichBoard board) override;
+
+private:
+  size_t permute(size_t aIndex) const;
+  uint8_t initialCode(size_t aIndex) const;
+  uint8_t currentCode(size_t aIndex) const;
+  void setCode(size_t aIndex, uint8_t aCode);
+  size_t slotOf(size_t aIndex) const;
+  void grow();
+
+  const size_t mSize;
+  const size_t mCells;
+  const size_t mInitialTargets;
+  size_t mTotalTargets;
+  size_t mTargetsAvailable;
+  size_t mNotAttackedSpotsRemaining;
+
+  // Feistel network over 2 * mHalfBits bits, the smallest even width that holds every cell index
+  const uint64_t mKey;
+  size_t mHalfBits;
+
+  // Touched cells, each slot is ((index + 1) << 2) | code, or 0 if empty. It grows during the battle, so it is kept on
+  // the heap rather than in BattleshipMemory, whose chunks are locked to allocate and never reuse freed memory.
+  std::vector<uint32_t> mTouched;
+  size_t mTouchedCount;
+  BattleshipRandom mRng;
+};
+
+#endif
@@ -0,0 +1,226 @@
+/**
+* @Filename: BattleshipMemory.cpp
+* @Author:   Ben Sokol <Ben>
+* @Email:    ben@bensokol.com
+* @Created:  October 18th, 2026 [8:25pm]
+* @Modified: October 19th, 2026 [1:20am]
+* @Version:  1.0.0
+*
+* Copyright (C) 2019 by Ben Sokol. All Rights Reserved.
+*/
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <string>
+#include <vector>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+#include "BattleshipMemory.hpp"
+
+
+namespace {
+  const size_t ALIGNMENT = 64;
+  const size_t HUGE_PAGE_SIZE = size_t(2) << 20;
+
+  const char *NAMES[BattleshipMemory::PAGES_COUNT] = { "off", "thp", "explicit" };
+
+  size_t roundUp(size_t aValue, size_t aMultiple) {
+    return (aValue + aMultiple - 1) / aMultiple * aMultiple;
+  }
+}  // namespace
+
+
+struct BattleshipMemory::chunk_t {
+  char *base = nullptr;
+  size_t size = 0;
+  size_t used = 0;
+  bool explicitHuge = false;
+
+  ~chunk_t() {
+#ifdef __linux__
+    if (base) {
+      munmap(base, size);
+    }
+#endif
+  }
+};
+
+
+std::mutex BattleshipMemory::sMtx;
+BattleshipMemory::PAGES BattleshipMemory::sPages = BattleshipMemory::PAGES_HEAP;
+size_t BattleshipMemory::sChunkSize = size_t(64) << 20;
+std::vector<std::unique_ptr<BattleshipMemory::chunk_t>> BattleshipMemory::sChunks;
+
+
+bool BattleshipMemory::configure(PAGES aPages, size_t aChunkSize) {
+  std::lock_guard<std::mutex> lck(sMtx);
+  if (!sChunks.empty() || (aPages != PAGES_HEAP && !isSupported())) {
+    return false;
+  }
+  sPages = aPages;
+  sChunkSize = roundUp(aChunkSize, HUGE_PAGE_SIZE);
+  return true;
+}
+
+
+BattleshipMemory::PAGES BattleshipMemory::getPages() {
+  return sPages;
+}
+
+
+const char *BattleshipMemory::getName(PAGES aPages) {
+  return aPages < PAGES_COUNT ? NAMES[aPages] : "unknown";
+}
+
+
+bool BattleshipMemory::isSupported() {
+#ifdef __linux__
+  return true;
+#else
+  return false;
+#endif
+}
+
+
+/****************************************************************
+* allocate:
+*   Bump allocation from the newest chunk, a new chunk is mapped
+*   when it is full. Only called while players are created, so one
+*   lock is enough. Storage that grows during the battle must not
+*   come from here, deallocate never reuses chunk memory.
+****************************************************************/
+void *BattleshipMemory::allocate(size_t aBytes) {
+  if (sPages == PAGES_HEAP) {
+    return ::operator new(aBytes, std::align_val_t(ALIGNMENT));
+  }
+
+  std::lock_guard<std::mutex> lck(sMtx);
+  aBytes = roundUp(aBytes == 0 ? 1 : aBytes, ALIGNMENT);
+  chunk_t *chunk = sChunks.empty() ? nullptr : sChunks.back().get();
+  if (!chunk || chunk->size - chunk->used < aBytes) {
+    chunk = addChunk(aBytes);
+    if (!chunk) {
+      throw std::bad_alloc();
+    }
+  }
+  void *ptr = chunk->base + chunk->used;
+  chunk->used += aBytes;
+  return ptr;
+}
+
+
+void BattleshipMemory::deallocate(void *aPtr) {
+  if (!aPtr) {
+    return;
+  }
+  {
+    // Chunk memory is released with the chunk
+    std::lock_guard<std::mutex> lck(sMtx);
+    for (auto &chunk : sChunks) {
+      if (static_cast<char *>(aPtr) >= chunk->base && static_cast<char *>(aPtr) < chunk->base + chunk->size) {
+        return;
+      }
+    }
+  }
+  ::operator delete(aPtr, std::align_val_t(ALIGNMENT));
+}
+
+
+/****************************************************************
+* addChunk:
+*   Caller must hold sMtx. Transparent huge page chunks are aligned
+*   to a huge page, so the kernel can back all of them with huge
+*   pages.
+****************************************************************/
+BattleshipMemory::chunk_t *BattleshipMemory::addChunk(size_t aBytes) {
+#ifdef __linux__
+  std::unique_ptr<chunk_t> chunk(new chunk_t());
+  chunk->size = roundUp(std::max(aBytes, sChunkSize), HUGE_PAGE_SIZE);
+
+  if (sPages == PAGES_EXPLICIT) {
+    void *base = mmap(nullptr, chunk->size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    if (base != MAP_FAILED) {
+      chunk->base = static_cast<char *>(base);
+      chunk->explicitHuge = true;
+    }
+  }
+
+  if (!chunk->base) {
+    const size_t mapped = chunk->size + HUGE_PAGE_SIZE;
+    void *base = mmap(nullptr, mapped, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (base == MAP_FAILED) {
+      return nullptr;
+    }
+
+    // Trim to a huge page boundary
+    const uintptr_t start = reinterpret_cast<uintptr_t>(base);
+    const uintptr_t aligned = roundUp(start, HUGE_PAGE_SIZE);
+    if (aligned > start) {
+      munmap(base, aligned - start);
+    }
+    munmap(reinterpret_cast<void *>(aligned + chunk->size), HUGE_PAGE_SIZE - (aligned - start));
+    chunk->base = reinterpret_cast<char *>(aligned);
+#ifdef MADV_HUGEPAGE
+    madvise(chunk->base, chunk->size, MADV_HUGEPAGE);
+#endif
+  }
+
+  sChunks.push_back(std::move(chunk));
+  return sChunks.back().get();
+#else
+  (void)aBytes;
+  return nullptr;
+#endif
+}
+
+
+/****************************************************************
+* getUsage:
+*   Transparent huge pages are whatever the kernel chose to give,
+*   so they are read back from /proc/self/smaps.
+****************************************************************/
+BattleshipMemory::usage_t BattleshipMemory::getUsage() {
+  std::lock_guard<std::mutex> lck(sMtx);
+  usage_t usage = {};
+  usage.chunks = sChunks.size();
+  for (auto &chunk : sChunks) {
+    usage.reservedBytes += chunk->size;
+    usage.usedBytes += chunk->used;
+    usage.explicitHugeBytes += chunk->explicitHuge ? chunk->size : 0;
+  }
+
+#ifdef __linux__
+  std::ifstream smaps("/proc/self/smaps");
+  std::string line;
+  bool inChunk = false;
+  while (std::getline(smaps, line)) {
+    unsigned long long start = 0;
+    unsigned long long end = 0;
+    if (std::sscanf(line.c_str(), "%llx-%llx ", &start, &end) == 2 && line.find(':') > line.find(' ')) {
+      // A mapping header, the kernel may have merged a chunk with its neighbours
+      inChunk = false;
+      for (auto &chunk : sChunks) {
+        const uintptr_t base = reinterpret_cast<uintptr_t>(chunk->base);
+        if (!chunk->explicitHuge && start < base + chunk->size && base < end) {
+          inChunk = true;
+        }
+      }
+    }
+    else if (inChunk && line.compare(0, 14, "AnonHugePages:") == 0) {
+      usage.transparentHugeBytes += std::strtoull(line.c_str() + 14, nullptr, 10) * 1024;
+    }
+  }
+  usage.transparentHugeBytes = std::min(usage.transparentHugeBytes, usage.reservedBytes - usage.explicitHugeBytes);
+#endif
+  return usage;
+}
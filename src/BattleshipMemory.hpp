@@ -0,0 +1,94 @@
+/**
+* @Filename: BattleshipMemory.hpp
+* @Author:   Ben Sokol <Ben>
+* @Email:    ben@bensokol.com
+* @Created:  October 18th, 2026 [8:25pm]
+* @Modified: October 19th, 2026 [1:20am]
+* @Version:  1.0.0
+*
+* Copyright (C) 2019 by Ben Sokol. All Rights Reserved.
+*/
+
+#ifndef BATTLESHIPMEMORY_HPP
+#define BATTLESHIPMEMORY_HPP
+
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Storage for players and boards. By default this is the heap. Once configured for huge pages, allocations are carved
+// out of large mmap'd chunks backed by transparent (madvise(MADV_HUGEPAGE)) or explicit (MAP_HUGETLB) huge pages, so
+// random attacks across many boards need far fewer TLB entries. Chunk memory is only given back when the process
+// exits, which suits players and boards since they live for the whole run. Anything that grows during the battle,
+// such as a lazy board's table of touched cells, must stay on the heap.
+class BattleshipMemory {
+public:
+  enum PAGES {
+    PAGES_HEAP,         // new and delete
+    PAGES_TRANSPARENT,  // mmap, then madvise(MADV_HUGEPAGE)
+    PAGES_EXPLICIT,     // mmap(MAP_HUGETLB), falling back to PAGES_TRANSPARENT if none are reserved
+    PAGES_COUNT
+  };
+
+  struct usage_t {
+    size_t chunks;
+    size_t reservedBytes;
+    size_t usedBytes;
+    size_t explicitHugeBytes;     // in MAP_HUGETLB chunks
+    size_t transparentHugeBytes;  // AnonHugePages of the other chunks, Linux only
+  };
+
+  // Must be called before anything is allocated
+  static bool configure(PAGES aPages, size_t aChunkSize = size_t(64) << 20);
+  static PAGES getPages();
+  static const char *getName(PAGES aPages);
+  static bool isSupported();
+
+  // 64 byte aligned
+  static void *allocate(size_t aBytes);
+  static void deallocate(void *aPtr);
+
+  static usage_t getUsage();
+
+private:
+  struct chunk_t;
+
+  static chunk_t *addChunk(size_t aBytes);
+
+  static std::mutex sMtx;
+  static PAGES sPages;
+  static size_t sChunkSize;
+  static std::vector<std::unique_ptr<chunk_t>> sChunks;
+};
+
+
+// Standard allocator over BattleshipMemory, for containers owned by a board or player
+template <typename T>
+class BattleshipAllocator {
+public:
+  typedef T value_type;
+
+  BattleshipAllocator() = default;
+  template <typename U>
+  BattleshipAllocator(const BattleshipAllocator<U> &) {}
+
+  T *allocate(size_t aCount) {
+    return static_cast<T *>(BattleshipMemory::allocate(aCount * sizeof(T)));
+  }
+  void deallocate(T *aPtr, size_t) {
+    BattleshipMemory::deallocate(aPtr);
+  }
+
+  template <typename U>
+  bool operator==(const BattleshipAllocator<U> &) const {
+    return true;
+  }
+  template <typename U>
+  bool operator!=(const BattleshipAllocator<U> &) const {
+    return false;
+  }
+};
+
+#endif
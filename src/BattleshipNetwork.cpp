@@ -0,0 +1,655 @@
+/**
+* @Filename: BattleshipNetwork.cpp
+* @Author:   Ben Sokol <Ben>
+* @Email:    ben@bensokol.com
+* @Created:  October 18th, 2026 [9:02am]
+* @Modified: October 19th, 2026 [2:20am]
+* @Version:  1.0.0
+*
+* Copyright (C) 2019 by Ben Sokol. All Rights Reserved.
+*/
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <arpa/inet.h>
+
+#ifdef __linux__
+#include <cerrno>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+#include "UTL_assert.h"
+
+#include "BattleshipAllocations.hpp"
+#include "BattleshipNetwork.hpp"
+
+
+struct BattleshipNetwork::link_t {
+  link_t()
+      : fd(-1),
+        byeReceived(false),
+        bytesSent(0),
+        bytesReceived(0),
+        messagesSent(0),
+        messagesReceived(0),
+        batchesSent(0) {}
+
+  int fd;
+  bool byeReceived;  // Only touched by the event loop
+
+  // Guards batch and outbound, player threads and the event loop both send
+  std::mutex mtx;
+  std::vector<message_t> batch;
+  std::string outbound;
+  std::string inbound;  // Only touched by the event loop
+
+  std::atomic<size_t> bytesSent;
+  std::atomic<size_t> bytesReceived;
+  std::atomic<size_t> messagesSent;
+  std::atomic<size_t> messagesReceived;
+  std::atomic<size_t> batchesSent;
+};
+
+
+namespace {
+  const size_t HEADER_SIZE = sizeof(uint32_t);
+  const size_t MESSAGE_SIZE = 4 * sizeof(uint32_t);
+  const int FLUSH_INTERVAL_MS = 1;
+  const int CONNECT_TIMEOUT_MS = 30000;
+
+  void appendU32(std::string &str, uint32_t value) {
+    value = htonl(value);
+    str.append(reinterpret_cast<const char *>(&value), sizeof(value));
+  }
+
+  uint32_t readU32(const char *buffer) {
+    uint32_t value;
+    std::memcpy(&value, buffer, sizeof(value));
+    return ntohl(value);
+  }
+
+  bool splitEndpoint(const std::string &aEndpoint, std::string &aHost, std::string &aPort) {
+    const size_t pos = aEndpoint.rfind(':');
+    if (pos == std::string::npos || pos == 0 || pos == aEndpoint.size() - 1) {
+      return false;
+    }
+    aHost = aEndpoint.substr(0, pos);
+    aPort = aEndpoint.substr(pos + 1);
+    return true;
+  }
+}  // namespace
+
+
+BattleshipNetwork::BattleshipNetwork(size_t aNodeId, const std::vector<std::string> &aPeers, size_t aBatchSize)
+    : mNodeId(aNodeId),
+      mPeers(aPeers),
+      mBatchSize(aBatchSize > 0 ? aBatchSize : 1),
+      mListenFd(-1),
+      mEpollFd(-1),
+      mWakeFd(-1),
+      mStopping(false) {
+  UTL_assert(mNodeId < mPeers.size());
+  for (size_t i = 0; i < mPeers.size(); ++i) {
+    mLinks.emplace_back(i == mNodeId ? nullptr : new link_t());
+    if (mLinks.back()) {
+      mLinks.back()->batch.reserve(mBatchSize);
+      mLinks.back()->outbound.reserve(HEADER_SIZE + mBatchSize * MESSAGE_SIZE);
+    }
+  }
+}
+
+
+BattleshipNetwork::~BattleshipNetwork() {
+  if (mEventLoop.joinable()) {
+    stop();
+  }
+}
+
+
+/****************************************************************
+* isSupported:
+*   The transport is built on epoll and eventfd.
+****************************************************************/
+bool BattleshipNetwork::isSupported() {
+#ifdef __linux__
+  return true;
+#else
+  return false;
+#endif
+}
+
+
+/****************************************************************
+* parsePeers:
+*   Splits a comma separated list of host:port endpoints.
+****************************************************************/
+bool BattleshipNetwork::parsePeers(const std::string &aPeers, std::vector<std::string> &aEndpoints) {
+  aEndpoints.clear();
+  size_t begin = 0;
+  while (begin <= aPeers.size()) {
+    size_t end = aPeers.find(',', begin);
+    if (end == std::string::npos) {
+      end = aPeers.size();
+    }
+    std::string host;
+    std::string port;
+    if (!splitEndpoint(aPeers.substr(begin, end - begin), host, port)) {
+      return false;
+    }
+    aEndpoints.push_back(aPeers.substr(begin, end - begin));
+    begin = end + 1;
+  }
+  return !aEndpoints.empty();
+}
+
+
+size_t BattleshipNetwork::getNodeId() const {
+  return mNodeId;
+}
+
+size_t BattleshipNetwork::getNodeCount() const {
+  return mPeers.size();
+}
+
+size_t BattleshipNetwork::getBatchSize() const {
+  return mBatchSize;
+}
+
+const std::string &BattleshipNetwork::getError() const {
+  return mError;
+}
+
+BattleshipNetwork::linkStats_t BattleshipNetwork::getLinkStats(size_t aNode) const {
+  linkStats_t stats = {0, 0, 0, 0, 0};
+  if (aNode < mLinks.size() && mLinks[aNode]) {
+    const link_t &link = *mLinks[aNode];
+    stats.bytesSent = link.bytesSent.load(std::memory_order_relaxed);
+    stats.bytesReceived = link.bytesReceived.load(std::memory_order_relaxed);
+    stats.messagesSent = link.messagesSent.load(std::memory_order_relaxed);
+    stats.messagesReceived = link.messagesReceived.load(std::memory_order_relaxed);
+    stats.batchesSent = link.batchesSent.load(std::memory_order_relaxed);
+  }
+  return stats;
+}
+
+
+/****************************************************************
+* send:
+*   Queues a message for aNode. Messages are framed once a batch
+*   is full, partial batches are flushed by the event loop.
+****************************************************************/
+void BattleshipNetwork::send(size_t aNode, const message_t &aMessage) {
+  UTL_assert(aNode < mLinks.size() && mLinks[aNode]);
+  link_t &link = *mLinks[aNode];
+  bool full = false;
+  {
+    // The batch and a frame of outbound are reserved, outbound only grows while the socket falls behind
+    BattleshipAllocations::Allow allow;
+    std::lock_guard<std::mutex> lck(link.mtx);
+    link.batch.push_back(aMessage);
+    if (link.batch.size() >= mBatchSize) {
+      frameBatch(link);
+      full = true;
+    }
+  }
+  if (full) {
+    wake();
+  }
+}
+
+
+void BattleshipNetwork::broadcast(const message_t &aMessage) {
+  for (size_t i = 0; i < mLinks.size(); ++i) {
+    if (mLinks[i]) {
+      send(i, aMessage);
+    }
+  }
+}
+
+
+/****************************************************************
+* frameBatch:
+*   Moves the pending batch into the outbound buffer as one
+*   length prefixed frame. Caller must hold aLink.mtx.
+****************************************************************/
+void BattleshipNetwork::frameBatch(link_t &aLink) {
+  if (aLink.batch.empty()) {
+    return;
+  }
+  const size_t length = aLink.batch.size() * MESSAGE_SIZE;
+  appendU32(aLink.outbound, static_cast<uint32_t>(length));
+  for (const message_t &message : aLink.batch) {
+    appendU32(aLink.outbound, message.type);
+    appendU32(aLink.outbound, message.player);
+    appendU32(aLink.outbound, message.target);
+    appendU32(aLink.outbound, message.value);
+  }
+  aLink.messagesSent.fetch_add(aLink.batch.size(), std::memory_order_relaxed);
+  aLink.batchesSent.fetch_add(1, std::memory_order_relaxed);
+  aLink.batch.clear();
+}
+
+
+#ifdef __linux__
+
+/****************************************************************
+* start:
+*   Builds a full mesh. Every node listens, connects to the nodes
+*   with a higher id, and accepts the nodes with a lower id. The
+*   sockets are then handed to a single epoll event loop.
+****************************************************************/
+bool BattleshipNetwork::start(handler_t aHandler) {
+  mHandler = aHandler;
+
+  if (!listenForPeers()) {
+    return false;
+  }
+
+  for (size_t i = mNodeId + 1; i < mPeers.size(); ++i) {
+    if (!connectToPeer(i)) {
+      return false;
+    }
+  }
+
+  for (size_t i = 0; i < mNodeId; ++i) {
+    if (!acceptPeer()) {
+      return false;
+    }
+  }
+
+  mEpollFd = epoll_create1(0);
+  mWakeFd = eventfd(0, EFD_NONBLOCK);
+  if (mEpollFd == -1 || mWakeFd == -1) {
+    mError = "Unable to create event loop (errno " + std::to_string(errno) + ")";
+    return false;
+  }
+
+  epoll_event event;
+  std::memset(&event, 0, sizeof(event));
+  event.events = EPOLLIN;
+  event.data.u64 = mLinks.size();
+  epoll_ctl(mEpollFd, EPOLL_CTL_ADD, mWakeFd, &event);
+
+  for (size_t i = 0; i < mLinks.size(); ++i) {
+    if (!mLinks[i]) {
+      continue;
+    }
+    const int fd = mLinks[i]->fd;
+    const int flag = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &flag, sizeof(flag));
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+    event.events = EPOLLIN;
+    event.data.u64 = i;
+    epoll_ctl(mEpollFd, EPOLL_CTL_ADD, fd, &event);
+  }
+
+  close(mListenFd);
+  mListenFd = -1;
+
+  mEventLoop = std::thread(&BattleshipNetwork::eventLoop, this);
+  return true;
+}
+
+
+/****************************************************************
+* stop:
+*   Says goodbye to every peer and keeps the event loop running
+*   until every peer has said goodbye and all data is written.
+****************************************************************/
+void BattleshipNetwork::stop() {
+  if (!mEventLoop.joinable()) {
+    return;
+  }
+  message_t bye = { MESSAGE_BYE, static_cast<uint32_t>(mNodeId), 0, 0 };
+  broadcast(bye);
+  mStopping.store(true);
+  wake();
+  mEventLoop.join();
+
+  for (size_t i = 0; i < mLinks.size(); ++i) {
+    if (mLinks[i] && mLinks[i]->fd != -1) {
+      close(mLinks[i]->fd);
+      mLinks[i]->fd = -1;
+    }
+  }
+  close(mWakeFd);
+  close(mEpollFd);
+  mWakeFd = -1;
+  mEpollFd = -1;
+}
+
+
+bool BattleshipNetwork::listenForPeers() {
+  std::string host;
+  std::string port;
+  splitEndpoint(mPeers[mNodeId], host, port);
+
+  addrinfo hints;
+  std::memset(&hints, 0, sizeof(hints));
+  hints.ai_family = AF_UNSPEC;
+  hints.ai_socktype = SOCK_STREAM;
+  hints.ai_flags = AI_PASSIVE;
+  addrinfo *result = nullptr;
+  if (getaddrinfo(host.c_str(), port.c_str(), &hints, &result) != 0 || result == nullptr) {
+    mError = "Unable to resolve " + mPeers[mNodeId];
+    return false;
+  }
+
+  mListenFd = socket(result->ai_family, result->ai_socktype, result->ai_protocol);
+  const int flag = 1;
+  const bool ok = mListenFd != -1 && setsockopt(mListenFd, SOL_SOCKET, SO_REUSEADDR, &flag, sizeof(flag)) == 0
+                  && bind(mListenFd, result->ai_addr, result->ai_addrlen) == 0
+                  && listen(mListenFd, static_cast<int>(mPeers.size())) == 0;
+  freeaddrinfo(result);
+  if (!ok) {
+    mError = "Unable to listen on " + mPeers[mNodeId] + " (errno " + std::to_string(errno) + ")";
+    return false;
+  }
+  return true;
+}
+
+
+bool BattleshipNetwork::connectToPeer(size_t aNode) {
+  std::string host;
+  std::string port;
+  splitEndpoint(mPeers[aNode], host, port);
+
+  addrinfo hints;
+  std::memset(&hints, 0, sizeof(hints));
+  hints.ai_family = AF_UNSPEC;
+  hints.ai_socktype = SOCK_STREAM;
+  addrinfo *result = nullptr;
+  if (getaddrinfo(host.c_str(), port.c_str(), &hints, &result) != 0 || result == nullptr) {
+    mError = "Unable to resolve " + mPeers[aNode];
+    return false;
+  }
+
+  // Peers may still be starting, keep retrying until the timeout
+  int fd = -1;
+  for (int waited = 0; waited < CONNECT_TIMEOUT_MS; waited += 100) {
+    fd = socket(result->ai_family, result->ai_socktype, result->ai_protocol);
+    if (fd != -1 && connect(fd, result->ai_addr, result->ai_addrlen) == 0) {
+      break;
+    }
+    if (fd != -1) {
+      close(fd);
+      fd = -1;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  }
+  freeaddrinfo(result);
+  if (fd == -1) {
+    mError = "Unable to connect to " + mPeers[aNode];
+    return false;
+  }
+
+  // Identify ourselves, the socket is still blocking here
+  std::string hello;
+  appendU32(hello, static_cast<uint32_t>(MESSAGE_SIZE));
+  appendU32(hello, MESSAGE_HELLO);
+  appendU32(hello, static_cast<uint32_t>(mNodeId));
+  appendU32(hello, 0);
+  appendU32(hello, 0);
+  if (::send(fd, hello.data(), hello.size(), MSG_NOSIGNAL) != static_cast<ssize_t>(hello.size())) {
+    close(fd);
+    mError = "Unable to greet " + mPeers[aNode];
+    return false;
+  }
+  mLinks[aNode]->fd = fd;
+  return true;
+}
+
+
+bool BattleshipNetwork::acceptPeer() {
+  const int fd = accept(mListenFd, nullptr, nullptr);
+  if (fd == -1) {
+    mError = "Unable to accept peer (errno " + std::to_string(errno) + ")";
+    return false;
+  }
+
+  char hello[HEADER_SIZE + MESSAGE_SIZE];
+  size_t received = 0;
+  while (received < sizeof(hello)) {
+    const ssize_t n = recv(fd, hello + received, sizeof(hello) - received, 0);
+    if (n <= 0) {
+      close(fd);
+      mError = "Peer disconnected during handshake";
+      return false;
+    }
+    received += static_cast<size_t>(n);
+  }
+
+  const size_t node = readU32(hello + HEADER_SIZE + sizeof(uint32_t));
+  if (readU32(hello + HEADER_SIZE) != MESSAGE_HELLO || node >= mNodeId || mLinks[node]->fd != -1) {
+    close(fd);
+    mError = "Unexpected handshake from peer";
+    return false;
+  }
+  mLinks[node]->fd = fd;
+  return true;
+}
+
+
+void BattleshipNetwork::wake() {
+  if (mWakeFd != -1) {
+    const uint64_t one = 1;
+    ssize_t ignored = write(mWakeFd, &one, sizeof(one));
+    (void)ignored;
+  }
+}
+
+
+/****************************************************************
+* eventLoop:
+*   The only thread that touches the sockets. Partial batches are
+*   flushed at least every FLUSH_INTERVAL_MS.
+****************************************************************/
+void BattleshipNetwork::eventLoop() {
+  std::vector<epoll_event> events(mLinks.size() + 1);
+
+  while (true) {
+    const int count = epoll_wait(mEpollFd, events.data(), static_cast<int>(events.size()), FLUSH_INTERVAL_MS);
+    for (int i = 0; i < count; ++i) {
+      const size_t node = events[i].data.u64;
+      if (node == mLinks.size()) {
+        uint64_t ignored;
+        while (read(mWakeFd, &ignored, sizeof(ignored)) > 0) {
+        }
+        continue;
+      }
+      if (events[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR)) {
+        readLink(node, *mLinks[node]);
+      }
+    }
+
+    // Flush batches and write whatever the sockets accept
+    bool drained = true;
+    bool byes = true;
+    for (size_t node = 0; node < mLinks.size(); ++node) {
+      if (!mLinks[node]) {
+        continue;
+      }
+      link_t &link = *mLinks[node];
+      std::lock_guard<std::mutex> lck(link.mtx);
+      frameBatch(link);
+      if (link.fd != -1 && !writeLink(link)) {
+        drained = false;
+      }
+      byes = byes && link.byeReceived;
+    }
+
+    if (mStopping.load() && drained && byes) {
+      return;
+    }
+  }
+}
+
+
+/****************************************************************
+* writeLink:
+*   Writes as much of the outbound buffer as the socket accepts.
+*   Returns true once the buffer is empty. Caller holds aLink.mtx.
+****************************************************************/
+bool BattleshipNetwork::writeLink(link_t &aLink) {
+  size_t written = 0;
+  while (written < aLink.outbound.size()) {
+    const ssize_t n = ::send(aLink.fd, aLink.outbound.data() + written, aLink.outbound.size() - written, MSG_NOSIGNAL);
+    if (n > 0) {
+      written += static_cast<size_t>(n);
+    }
+    else if (n == -1 && errno == EINTR) {
+      continue;
+    }
+    else if (n == -1 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+      break;
+    }
+    else {
+      // Peer is gone, nothing we queue will ever arrive
+      aLink.outbound.clear();
+      closeLink(aLink);
+      return true;
+    }
+  }
+  aLink.bytesSent.fetch_add(written, std::memory_order_relaxed);
+  aLink.outbound.erase(0, written);
+  return aLink.outbound.empty();
+}
+
+
+/****************************************************************
+* readLink:
+*   Reads every available byte and dispatches complete frames.
+*   Every node sends at most --net-batch whole messages per frame,
+*   so any other length is corrupt and closes the link, rather
+*   than buffering up to 4 GiB waiting for it. So does a frame with
+*   a message type the handler does not know, which is checked
+*   before any of the frame is dispatched.
+****************************************************************/
+void BattleshipNetwork::readLink(size_t aNode, link_t &aLink) {
+  char buffer[64 * 1024];
+  while (aLink.fd != -1) {
+    const ssize_t n = recv(aLink.fd, buffer, sizeof(buffer), 0);
+    if (n > 0) {
+      aLink.inbound.append(buffer, static_cast<size_t>(n));
+      aLink.bytesReceived.fetch_add(static_cast<size_t>(n), std::memory_order_relaxed);
+    }
+    else if (n == -1 && errno == EINTR) {
+      continue;
+    }
+    else if (n == -1 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+      break;
+    }
+    else {
+      std::lock_guard<std::mutex> lck(aLink.mtx);
+      aLink.outbound.clear();
+      closeLink(aLink);
+    }
+  }
+
+  size_t offset = 0;
+  std::string error;
+  while (aLink.inbound.size() - offset >= HEADER_SIZE) {
+    const size_t length = readU32(aLink.inbound.data() + offset);
+    if (length > mBatchSize * MESSAGE_SIZE || length % MESSAGE_SIZE != 0) {
+      error = "Malformed frame of " + std::to_string(length) + " bytes from " + mPeers[aNode];
+      break;
+    }
+    if (aLink.inbound.size() - offset - HEADER_SIZE < length) {
+      break;
+    }
+    const char *record = aLink.inbound.data() + offset + HEADER_SIZE;
+    for (size_t i = 0; i < length && error.empty(); i += MESSAGE_SIZE) {
+      const uint32_t type = readU32(record + i);
+      if (type == MESSAGE_HELLO || type >= MESSAGE_COUNT) {
+        error = "Unknown message type " + std::to_string(type) + " from " + mPeers[aNode];
+      }
+    }
+    if (!error.empty()) {
+      break;
+    }
+    for (size_t i = 0; i < length; i += MESSAGE_SIZE) {
+      message_t message;
+      message.type = readU32(record + i);
+      message.player = readU32(record + i + 4);
+      message.target = readU32(record + i + 8);
+      message.value = readU32(record + i + 12);
+      aLink.messagesReceived.fetch_add(1, std::memory_order_relaxed);
+      if (message.type == MESSAGE_BYE) {
+        aLink.byeReceived = true;
+      }
+      else if (mHandler) {
+        mHandler(aNode, message);
+      }
+    }
+    offset += HEADER_SIZE + length;
+  }
+
+  if (!error.empty()) {
+    mError = error;
+    std::lock_guard<std::mutex> lck(aLink.mtx);
+    aLink.outbound.clear();
+    aLink.inbound.clear();
+    closeLink(aLink);
+    return;
+  }
+  aLink.inbound.erase(0, offset);
+}
+
+
+void BattleshipNetwork::closeLink(link_t &aLink) {
+  if (aLink.fd != -1) {
+    epoll_ctl(mEpollFd, EPOLL_CTL_DEL, aLink.fd, nullptr);
+    close(aLink.fd);
+    aLink.fd = -1;
+  }
+  aLink.byeReceived = true;
+}
+
+#else
+
+bool BattleshipNetwork::start(handler_t aHandler) {
+  mHandler = aHandler;
+  mError = "Distributed mode requires Linux (epoll)";
+  return false;
+}
+
+void BattleshipNetwork::stop() {}
+
+bool BattleshipNetwork::listenForPeers() {
+  return false;
+}
+
+bool BattleshipNetwork::connectToPeer(size_t) {
+  return false;
+}
+
+bool BattleshipNetwork::acceptPeer() {
+  return false;
+}
+
+void BattleshipNetwork::eventLoop() {}
+
+void BattleshipNetwork::wake() {}
+
+bool BattleshipNetwork::writeLink(link_t &) {
+  return true;
+}
+
+void BattleshipNetwork::readLink(size_t, link_t &) {}
+
+void BattleshipNetwork::closeLink(link_t &) {}
+
+#endif
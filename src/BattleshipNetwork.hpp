@@ -0,0 +1,103 @@
+/**
+* @Filename: BattleshipNetwork.hpp
+* @Author:   Ben Sokol <Ben>
+* @Email:    ben@bensokol.com
+* @Created:  October 18th, 2026 [9:02am]
+* @Modified: October 19th, 2026 [12:55am]
+* @Version:  1.0.0
+*
+* Copyright (C) 2019 by Ben Sokol. All Rights Reserved.
+*/
+
+#ifndef BATTLESHIPNETWORK_HPP
+#define BATTLESHIPNETWORK_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+class BattleshipNetwork {
+public:
+  enum MESSAGE_TYPE : uint32_t {
+    MESSAGE_HELLO,   // player = node id of the sender
+    MESSAGE_ATTACK,  // player attacks target
+    MESSAGE_RESULT,  // value = BattleshipBoard::ATTACK_RESULT of an ATTACK
+    MESSAGE_STATUS,  // target is alive (value = 1) or dead (value = 0)
+    MESSAGE_DONE,    // value = winner
+    MESSAGE_BYE,     // sender will not send anything else
+    MESSAGE_COUNT
+  };
+
+  // Messages are fixed size records. A frame is a 32 bit length followed by a batch of messages, all fields are sent
+  // in network byte order.
+  struct message_t {
+    uint32_t type;
+    uint32_t player;
+    uint32_t target;
+    uint32_t value;
+  };
+
+  struct linkStats_t {
+    size_t bytesSent;
+    size_t bytesReceived;
+    size_t messagesSent;
+    size_t messagesReceived;
+    size_t batchesSent;
+  };
+
+  typedef std::function<void(size_t, const message_t &)> handler_t;
+
+  BattleshipNetwork(size_t aNodeId, const std::vector<std::string> &aPeers, size_t aBatchSize = 64);
+  ~BattleshipNetwork();
+
+  static bool isSupported();
+  static bool parsePeers(const std::string &aPeers, std::vector<std::string> &aEndpoints);
+
+  bool start(handler_t aHandler);
+  void stop();
+
+  void send(size_t aNode, const message_t &aMessage);
+  void broadcast(const message_t &aMessage);
+
+  size_t getNodeId() const;
+  size_t getNodeCount() const;
+  size_t getBatchSize() const;
+  linkStats_t getLinkStats(size_t aNode) const;
+  // Set by start, or by the event loop when a peer sends a corrupt frame, so only read it once stopped
+  const std::string &getError() const;
+
+private:
+  struct link_t;
+
+  bool listenForPeers();
+  bool connectToPeer(size_t aNode);
+  bool acceptPeer();
+  void eventLoop();
+  void wake();
+  void frameBatch(link_t &aLink);
+  bool writeLink(link_t &aLink);
+  void readLink(size_t aNode, link_t &aLink);
+  void closeLink(link_t &aLink);
+
+  const size_t mNodeId;
+  const std::vector<std::string> mPeers;
+  const size_t mBatchSize;
+
+  std::vector<std::unique_ptr<link_t>> mLinks;
+  int mListenFd;
+  int mEpollFd;
+  int mWakeFd;
+
+  handler_t mHandler;
+  std::thread mEventLoop;
+  std::atomic<bool> mStopping;
+  std::string mError;
+};
+
+#endif
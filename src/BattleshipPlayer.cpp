@@ -3,26 +3,47 @@
 * @Author:   Ben Sokol <Ben>
 * @Email:    ben@bensokol.com
 * @Created:  February 15th, 2019 [10:58am]
-* @Modified: February 22nd, 2019 [11:43pm]
+* @Modified: October 18th, 2026 [11:45pm]
 * @Version:  1.0.0
 *
 * Copyright (C) 2019 by Ben Sokol. All Rights Reserved.
 */
 
 #include <algorithm>
+#include <atomic>
+#include <charconv>
 #include <cstdlib>
+#include <cstring>
 #include <iostream>
 #include <mutex>
 #include <random>
 #include <string>
 #include <utility>
 
+#include "BattleshipMemory.hpp"
+#include "BattleshipTrace.hpp"
 #include "UTL_assert.h"
 
 #include "BattleshipPlayer.hpp"
 
-BattleshipPlayer::BattleshipPlayer(size_t aPlayerNum, size_t aSize, size_t aTotalTargets)
-    : mBoard(std::shared_ptr<BattleshipBoard>(new BattleshipBoard(aSize, aTotalTargets))),
+
+namespace {
+  // aLabel, aValue and aEnd, with the digits written straight into aReport
+  void appendLine(std::string &aReport, const char *aLabel, size_t aValue, const char *aEnd = "\n") {
+    char digits[24];
+    const std::to_chars_result result = std::to_chars(digits, digits + sizeof(digits), aValue);
+    aReport += aLabel;
+    aReport.append(digits, result.ptr);
+    aReport += aEnd;
+  }
+}  // namespace
+
+BattleshipPlayer::BattleshipPlayer(size_t aPlayerNum,
+                                   size_t aSize,
+                                   size_t aTotalTargets,
+                                   uint64_t aSeed,
+                                   BattleshipBoard::STORAGE aStorage)
+    : mBoard(BattleshipBoard::create(aSize, aTotalTargets, aSeed, aStorage)),
       mPlayerNum(aPlayerNum),
       mIsAlive(true),
       mTimesRevived(0),
@@ -30,27 +51,101 @@ BattleshipPlayer::BattleshipPlayer(size_t aPlayerNum, size_t aSize, size_t aTota
       mAttacksLaunchedInitialHits(0),
       mAttacksLaunchedInitialMisses(0),
       mAttacksLaunchedSecondaryHits(0),
-      mAttacksLaunchedSecondaryMisses(0) {
+      mAttacksLaunchedSecondaryMisses(0),
+      mStatsSeq(0) {
   UTL_assert(aTotalTargets <= (aSize * aSize));
+  publishStats();
+}
+
+
+BattleshipPlayer::BattleshipPlayer(size_t aPlayerNum,
+                                   size_t aSize,
+                                   const state_t &aState,
+                                   const uint8_t *aInitialCells,
+                                   const uint8_t *aCurrentCells)
+    : mBoard(BattleshipBoard::restore(aSize, aState.board, aInitialCells, aCurrentCells)),
+      mPlayerNum(aPlayerNum),
+      mIsAlive(aState.isAlive != 0),
+      mTimesRevived(aState.timesRevived),
+      mAttacksReceived(aState.attacksReceived),
+      mAttacksLaunchedInitialHits(aState.attacksLaunchedInitialHits),
+      mAttacksLaunchedInitialMisses(aState.attacksLaunchedInitialMisses),
+      mAttacksLaunchedSecondaryHits(aState.attacksLaunchedSecondaryHits),
+      mAttacksLaunchedSecondaryMisses(aState.attacksLaunchedSecondaryMisses),
+      mStatsSeq(0) {
+  publishStats();
 }
 
 
 BattleshipPlayer::~BattleshipPlayer() {}
 
 
+void *BattleshipPlayer::operator new(size_t aBytes) {
+  return BattleshipMemory::allocate(aBytes);
+}
+
+
+void BattleshipPlayer::operator delete(void *aPtr) {
+  BattleshipMemory::deallocate(aPtr);
+}
+
+
+void BattleshipPlayer::saveState(state_t &aState, uint8_t *aInitialCells, uint8_t *aCurrentCells) {
+  std::lock_guard<std::recursive_mutex> lck(mMtx);
+  aState.isAlive = mIsAlive ? 1 : 0;
+  aState.timesRevived = mTimesRevived;
+  aState.attacksReceived = mAttacksReceived;
+  aState.attacksLaunchedInitialHits = mAttacksLaunchedInitialHits;
+  aState.attacksLaunchedInitialMisses = mAttacksLaunchedInitialMisses;
+  aState.attacksLaunchedSecondaryHits = mAttacksLaunchedSecondaryHits;
+  aState.attacksLaunchedSecondaryMisses = mAttacksLaunchedSecondaryMisses;
+  mBoard->saveState(aState.board, aInitialCells, aCurrentCells);
+}
+
+
 bool BattleshipPlayer::isAlive() {
   std::unique_lock<std::recursive_mutex> lck(mMtx);
   return mIsAlive;
 }
 
 
-void BattleshipPlayer::launchAttack(std::shared_ptr<BattleshipPlayer> target, BattleshipBoard::coordinate_t &coord) {
-  std::lock(mMtx, target->mMtx);
+void BattleshipPlayer::launchAttack(BattleshipPlayer &target, BattleshipBoard::coordinate_t &coord, bool *aSunk) {
+  BattleshipTrace::Span span("launchAttack");
+  {
+    BattleshipTrace::Span lockSpan("launchAttack lock");
+    std::lock(mMtx, target.mMtx);
+  }
   std::lock_guard<std::recursive_mutex> lck(mMtx, std::adopt_lock);
-  std::lock_guard<std::recursive_mutex> lckTarget(target->mMtx, std::adopt_lock);
+  std::lock_guard<std::recursive_mutex> lckTarget(target.mMtx, std::adopt_lock);
   UTL_assert(coord.getRow() != coord.invalid() && coord.getCol() != coord.invalid());
 
-  BattleshipBoard::ATTACK_RESULT result = target->mBoard->attackLocation(coord);
+  const bool wasAlive = target.mIsAlive;
+  recordAttackLaunched(target.receiveAttack(coord));
+  if (aSunk) {
+    *aSunk = wasAlive && !target.mIsAlive;
+  }
+}
+
+
+// Target side of an attack, used directly when the attacker lives on another node
+BattleshipBoard::ATTACK_RESULT BattleshipPlayer::receiveAttack(BattleshipBoard::coordinate_t &coord) {
+  std::lock_guard<std::recursive_mutex> lck(mMtx);
+  BattleshipBoard::ATTACK_RESULT result = mBoard->attackLocation(coord);
+
+  // Update target mAttacksReceived
+  mAttacksReceived++;
+
+  // Update target isAlive
+  mIsAlive = mBoard->isAlive();
+  publishStats();
+
+  return result;
+}
+
+
+// Attacker side of an attack
+void BattleshipPlayer::recordAttackLaunched(BattleshipBoard::ATTACK_RESULT result) {
+  std::lock_guard<std::recursive_mutex> lck(mMtx);
 
   // Update this attack launched status
   if (result == BattleshipBoard::ATTACK_RESULT_INITIAL_HIT) {
@@ -68,16 +163,99 @@ void BattleshipPlayer::launchAttack(std::shared_ptr<BattleshipPlayer> target, Ba
   else {
     UTL_assert_always();
   }
+  publishStats();
+}
 
-  // Update target mAttacksReceived
-  target->mAttacksReceived++;
 
-  // Update target isAlive
-  target->mIsAlive = target->mBoard->isAlive();
+size_t BattleshipPlayer::launchAttacks(BattleshipPlayer &target, size_t aCount, bool *aSunk) {
+  BattleshipTrace::Span span("launchAttacks");
+  {
+    BattleshipTrace::Span lockSpan("launchAttack lock");
+    std::lock(mMtx, target.mMtx);
+  }
+  std::lock_guard<std::recursive_mutex> lck(mMtx, std::adopt_lock);
+  std::lock_guard<std::recursive_mutex> lckTarget(target.mMtx, std::adopt_lock);
+  return fireSalvo(target, aCount, aSunk);
+}
+
+
+bool BattleshipPlayer::tryLaunchAttacks(BattleshipPlayer &target, size_t aCount, bool *aSunk) {
+  BattleshipTrace::Span span("tryLaunchAttacks");
+  if (std::try_lock(mMtx, target.mMtx) != -1) {
+    return false;
+  }
+  std::lock_guard<std::recursive_mutex> lck(mMtx, std::adopt_lock);
+  std::lock_guard<std::recursive_mutex> lckTarget(target.mMtx, std::adopt_lock);
+  fireSalvo(target, aCount, aSunk);
+  return true;
+}
+
+
+/****************************************************************
+* fireSalvo:
+*   Caller must hold both players' mutexes. Nothing is fired if
+*   either player died since the attack was chosen.
+****************************************************************/
+size_t BattleshipPlayer::fireSalvo(BattleshipPlayer &target, size_t aCount, bool *aSunk) {
+  UTL_assert(aCount <= MAX_ATTACK_BATCH);
+  if (aSunk) {
+    *aSunk = false;
+  }
+  if (!mIsAlive || !target.mIsAlive) {
+    return 0;
+  }
+
+  BattleshipBoard::attackCounts_t counts;
+  const size_t count = target.receiveSalvo(mPlayerNum, aCount, counts);
+  recordAttacksLaunched(counts);
+  if (aSunk) {
+    *aSunk = !target.mIsAlive;
+  }
+  return count;
+}
+
+
+void BattleshipPlayer::receiveAttacks(BattleshipBoard::attack_t *aAttacks,
+                                      size_t aCount,
+                                      BattleshipBoard::attackCounts_t &aCounts) {
+  std::lock_guard<std::recursive_mutex> lck(mMtx);
+  mBoard->attackLocations(aAttacks, aCount, aCounts);
+  mAttacksReceived += aCount;
+  mIsAlive = mBoard->isAlive();
+  publishStats();
+}
+
+
+size_t BattleshipPlayer::receiveSalvo(size_t aAttacker, size_t aCount, BattleshipBoard::attackCounts_t &aCounts) {
+  UTL_assert(aCount <= MAX_ATTACK_BATCH);
+  std::lock_guard<std::recursive_mutex> lck(mMtx);
+  BattleshipBoard::attack_t attacks[MAX_ATTACK_BATCH];
+  size_t count = 0;
+  for (; count < aCount; ++count) {
+    attacks[count].cell = getTargetCoordinates();
+    if (attacks[count].cell.getRow() == attacks[count].cell.invalid()) {
+      break;
+    }
+    attacks[count].attacker = static_cast<uint32_t>(aAttacker);
+    attacks[count].target = static_cast<uint32_t>(mPlayerNum);
+  }
+  receiveAttacks(attacks, count, aCounts);
+  return count;
+}
+
+
+void BattleshipPlayer::recordAttacksLaunched(const BattleshipBoard::attackCounts_t &aCounts) {
+  std::lock_guard<std::recursive_mutex> lck(mMtx);
+  mAttacksLaunchedInitialHits += aCounts.results[BattleshipBoard::ATTACK_RESULT_INITIAL_HIT];
+  mAttacksLaunchedInitialMisses += aCounts.results[BattleshipBoard::ATTACK_RESULT_INITIAL_MISS];
+  mAttacksLaunchedSecondaryHits += aCounts.results[BattleshipBoard::ATTACK_RESULT_SECONDARY_HIT];
+  mAttacksLaunchedSecondaryMisses += aCounts.results[BattleshipBoard::ATTACK_RESULT_SECONDARY_MISS];
+  publishStats();
 }
 
 
 BattleshipBoard::coordinate_t BattleshipPlayer::getTargetCoordinates() {
+  BattleshipTrace::Span span("getTargetCoordinates");
   std::lock_guard<std::recursive_mutex> lck(mMtx);
   if (!mIsAlive) {
     return BattleshipBoard::coordinate_t();
@@ -104,35 +282,99 @@ std::string BattleshipPlayer::printInitialBoard() {
 }
 
 
-std::string BattleshipPlayer::generateReport() {
+BattleshipBoard::footprint_t BattleshipPlayer::getBoardFootprint() {
   std::lock_guard<std::recursive_mutex> lck(mMtx);
+  return mBoard->getFootprint();
+}
 
-  const size_t attacksLaunched = mAttacksLaunchedInitialHits + mAttacksLaunchedInitialMisses
-                                 + mAttacksLaunchedSecondaryHits + mAttacksLaunchedSecondaryMisses;
 
-  std::string str = "";
+void BattleshipPlayer::appendReport(std::string &aReport) {
+  std::lock_guard<std::recursive_mutex> lck(mMtx);
 
-  str += "Player " + std::to_string(mPlayerNum) + " Report:\n";
-  str += "  Targets Remaining: " + std::to_string(mBoard->getRemainingTargets()) + "\n";
-  str += "  Times Revived: " + std::to_string(mTimesRevived) + "\n";
-  str += "  Attacks Received: " + std::to_string(mAttacksReceived) + "\n";
-  str += "  Attacks Launched: " + std::to_string(attacksLaunched) + "\n";
-  str += "    Details:\n";
-  str += "      Initial Hits:     " + std::to_string(mAttacksLaunchedInitialHits) + "\n";
-  str += "      Initial Misses:   " + std::to_string(mAttacksLaunchedInitialMisses) + "\n";
-  str += "      Secondary Hits:   " + std::to_string(mAttacksLaunchedSecondaryHits) + "\n";
-  str += "      Secondary Misses: " + std::to_string(mAttacksLaunchedSecondaryMisses) + "\n";
-  str += "\n";
+  const size_t attacksLaunched = mAttacksLaunchedInitialHits + mAttacksLaunchedInitialMisses
+                                 + mAttacksLaunchedSecondaryHits + mAttacksLaunchedSecondaryMisses;
 
-  return str;
+  appendLine(aReport, "Player ", mPlayerNum, " Report:\n");
+  appendLine(aReport, "  Targets Remaining: ", mBoard->getRemainingTargets());
+  appendLine(aReport, "  Times Revived: ", mTimesRevived);
+  appendLine(aReport, "  Attacks Received: ", mAttacksReceived);
+  appendLine(aReport, "  Attacks Launched: ", attacksLaunched);
+  aReport += "    Details:\n";
+  appendLine(aReport, "      Initial Hits:     ", mAttacksLaunchedInitialHits);
+  appendLine(aReport, "      Initial Misses:   ", mAttacksLaunchedInitialMisses);
+  appendLine(aReport, "      Secondary Hits:   ", mAttacksLaunchedSecondaryHits);
+  appendLine(aReport, "      Secondary Misses: ", mAttacksLaunchedSecondaryMisses);
+  aReport += "\n";
 }
 
 
 void BattleshipPlayer::revive() {
+  BattleshipTrace::Span span("revive");
   std::lock_guard<std::recursive_mutex> lck(mMtx);
   mBoard->revive(2);
   mTimesRevived++;
   mIsAlive = true;
+  publishStats();
+}
+
+
+void BattleshipPlayer::setView(BattleshipView::board_t *aView) {
+  std::lock_guard<std::recursive_mutex> lck(mMtx);
+  mBoard->setView(aView);
+}
+
+
+/****************************************************************
+* publishStats:
+*   Caller must hold mMtx, so there is only ever one writer. The
+*   release fence keeps the stores of the words after the odd
+*   sequence number.
+****************************************************************/
+void BattleshipPlayer::publishStats() {
+  const stats_t stats = { mIsAlive ? 1u : 0u,
+                          mBoard->getRemainingTargets(),
+                          mTimesRevived,
+                          mAttacksReceived,
+                          mAttacksLaunchedInitialHits,
+                          mAttacksLaunchedInitialMisses,
+                          mAttacksLaunchedSecondaryHits,
+                          mAttacksLaunchedSecondaryMisses };
+  uint64_t words[STATS_WORDS];
+  std::memcpy(words, &stats, sizeof(stats));
+
+  const uint64_t seq = mStatsSeq.load(std::memory_order_relaxed);
+  mStatsSeq.store(seq + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  for (size_t i = 0; i < STATS_WORDS; ++i) {
+    mStats[i].store(words[i], std::memory_order_relaxed);
+  }
+  mStatsSeq.store(seq + 2, std::memory_order_release);
+}
+
+
+/****************************************************************
+* snapshot:
+*   The acquire fence keeps the loads of the words before the
+*   second read of the sequence number.
+****************************************************************/
+BattleshipPlayer::stats_t BattleshipPlayer::snapshot() const {
+  uint64_t words[STATS_WORDS];
+  for (;;) {
+    const uint64_t seq = mStatsSeq.load(std::memory_order_acquire);
+    if ((seq & 1) == 0) {
+      for (size_t i = 0; i < STATS_WORDS; ++i) {
+        words[i] = mStats[i].load(std::memory_order_relaxed);
+      }
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (mStatsSeq.load(std::memory_order_relaxed) == seq) {
+        break;
+      }
+    }
+  }
+
+  stats_t stats;
+  std::memcpy(&stats, words, sizeof(stats));
+  return stats;
 }
 
 
@@ -141,24 +383,25 @@ size_t BattleshipPlayer::getPlayerNum() const {
 }
 
 
+// Lock free, read from the published stats
 size_t BattleshipPlayer::getRemainingTargets() const {
-  return mBoard->getRemainingTargets();
+  return snapshot().remainingTargets;
 }
 size_t BattleshipPlayer::getTimesRevived() const {
-  return mTimesRevived;
+  return snapshot().timesRevived;
 }
 size_t BattleshipPlayer::getAttacksReceived() const {
-  return mAttacksReceived;
+  return snapshot().attacksReceived;
 }
 size_t BattleshipPlayer::getAttacksLaunchedInitialHits() const {
-  return mAttacksLaunchedInitialHits;
+  return snapshot().attacksLaunchedInitialHits;
 }
 size_t BattleshipPlayer::getAttacksLaunchedInitialMisses() const {
-  return mAttacksLaunchedInitialMisses;
+  return snapshot().attacksLaunchedInitialMisses;
 }
 size_t BattleshipPlayer::getAttacksLaunchedSecondaryHits() const {
-  return mAttacksLaunchedSecondaryHits;
+  return snapshot().attacksLaunchedSecondaryHits;
 }
 size_t BattleshipPlayer::getAttacksLaunchedSecondaryMisses() const {
-  return mAttacksLaunchedSecondaryMisses;
+  return snapshot().attacksLaunchedSecondaryMisses;
 }
@@ -3,7 +3,7 @@
 * @Author:   Ben Sokol <Ben>
 * @Email:    ben@bensokol.com
 * @Created:  February 15th, 2019 [10:57am]
-* @Modified: February 22nd, 2019 [11:40pm]
+* @Modified: October 18th, 2026 [11:45pm]
 * @Version:  1.0.0
 *
 * Copyright (C) 2019 by Ben Sokol. All Rights Reserved.
@@ -12,6 +12,8 @@
 #ifndef BATTLESHIPPLAYER_HPP
 #define BATTLESHIPPLAYER_HPP
 
+#include <atomic>
+#include <cstdint>
 #include <cstdlib>
 #include <memory>
 #include <mutex>
@@ -22,22 +24,86 @@
 
 class BattleshipPlayer {
 public:
-  BattleshipPlayer(size_t aPlayerNum, size_t aSize, size_t aTotalTargets);
+  // Everything but the board cells, as stored in a checkpoint
+  struct state_t {
+    uint64_t isAlive;
+    uint64_t timesRevived;
+    uint64_t attacksReceived;
+    uint64_t attacksLaunchedInitialHits;
+    uint64_t attacksLaunchedInitialMisses;
+    uint64_t attacksLaunchedSecondaryHits;
+    uint64_t attacksLaunchedSecondaryMisses;
+    BattleshipBoard::state_t board;
+  };
+
+  // A player's stats at one moment, see snapshot
+  struct stats_t {
+    uint64_t isAlive;
+    uint64_t remainingTargets;
+    uint64_t timesRevived;
+    uint64_t attacksReceived;
+    uint64_t attacksLaunchedInitialHits;
+    uint64_t attacksLaunchedInitialMisses;
+    uint64_t attacksLaunchedSecondaryHits;
+    uint64_t attacksLaunchedSecondaryMisses;
+  };
+
+  BattleshipPlayer(size_t aPlayerNum,
+                   size_t aSize,
+                   size_t aTotalTargets,
+                   uint64_t aSeed,
+                   BattleshipBoard::STORAGE aStorage = BattleshipBoard::STORAGE_EAGER);
+  BattleshipPlayer(size_t aPlayerNum,
+                   size_t aSize,
+                   const state_t &aState,
+                   const uint8_t *aInitialCells,
+                   const uint8_t *aCurrentCells);
   ~BattleshipPlayer();
 
+  // Players are allocated from BattleshipMemory
+  static void *operator new(size_t aBytes);
+  static void operator delete(void *aPtr);
+
+  void saveState(state_t &aState, uint8_t *aInitialCells, uint8_t *aCurrentCells);
+
   bool isAlive();
-  void launchAttack(std::shared_ptr<BattleshipPlayer> target, BattleshipBoard::coordinate_t &coord);
+  // aSunk, if given, is set when the attack sank the target's last target
+  void launchAttack(BattleshipPlayer &target, BattleshipBoard::coordinate_t &coord, bool *aSunk = nullptr);
+  BattleshipBoard::ATTACK_RESULT receiveAttack(BattleshipBoard::coordinate_t &coord);
+  void recordAttackLaunched(BattleshipBoard::ATTACK_RESULT result);
+
+  // Fires a salvo of up to aCount (≤ MAX_ATTACK_BATCH) shots, chosen from the target's untouched cells before any of
+  // them land, under one lock of both players. Returns the number of shots fired.
+  static const size_t MAX_ATTACK_BATCH = 64;
+  size_t launchAttacks(BattleshipPlayer &target, size_t aCount, bool *aSunk = nullptr);
+  // Same as launchAttacks, but returns false without waiting if either player is locked
+  bool tryLaunchAttacks(BattleshipPlayer &target, size_t aCount, bool *aSunk = nullptr);
+  void receiveAttacks(BattleshipBoard::attack_t *aAttacks, size_t aCount, BattleshipBoard::attackCounts_t &aCounts);
+  // Target side of a salvo, aCount shots from aAttacker at this player's untouched cells. Returns the shots fired.
+  size_t receiveSalvo(size_t aAttacker, size_t aCount, BattleshipBoard::attackCounts_t &aCounts);
+  void recordAttacksLaunched(const BattleshipBoard::attackCounts_t &aCounts);
   std::string printBoard(BattleshipBoard::whichBoard board);
   std::string printCurrentBoard();
   std::string printInitialBoard();
   BattleshipBoard::coordinate_t getTargetCoordinates();
 
-  std::string generateReport();
+  // Appends the player's section of the report, about REPORT_BYTES characters, without building temporaries
+  static const size_t REPORT_BYTES = 320;
+  void appendReport(std::string &aReport);
 
   size_t getPlayerNum() const;
 
   void revive();
 
+  // --view, see BattleshipBoard::setView
+  void setView(BattleshipView::board_t *aView);
+
+  // Reads the stats without taking the player's lock, so it is safe while the battle runs and never makes the player
+  // wait. Retries while the player is publishing an update.
+  stats_t snapshot() const;
+
+  BattleshipBoard::footprint_t getBoardFootprint();
+
   size_t getRemainingTargets() const;
   size_t getTimesRevived() const;
   size_t getAttacksReceived() const;
@@ -47,7 +113,10 @@ public:
   size_t getAttacksLaunchedSecondaryMisses() const;
 
 private:
-  std::shared_ptr<BattleshipBoard> mBoard;
+  size_t fireSalvo(BattleshipPlayer &target, size_t aCount, bool *aSunk);
+  void publishStats();
+
+  std::unique_ptr<BattleshipBoard> mBoard;
   const size_t mPlayerNum;
   bool mIsAlive;
   std::recursive_mutex mMtx;
@@ -58,6 +127,12 @@ private:
   size_t mAttacksLaunchedInitialMisses;
   size_t mAttacksLaunchedSecondaryHits;
   size_t mAttacksLaunchedSecondaryMisses;
+
+  // Seqlock over a copy of the stats. Every update under mMtx is published by making mStatsSeq odd, storing the
+  // words, then making it even again. A reader retries if mStatsSeq was odd or changed while it read the words.
+  static const size_t STATS_WORDS = sizeof(stats_t) / sizeof(uint64_t);
+  std::atomic<uint64_t> mStatsSeq;
+  std::atomic<uint64_t> mStats[STATS_WORDS];
 };
 
 #endif
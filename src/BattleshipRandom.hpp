@@ -0,0 +1,59 @@
+/**
+* @Filename: BattleshipRandom.hpp
+* @Author:   Ben Sokol <Ben>
+* @Email:    ben@bensokol.com
+* @Created:  October 18th, 2026 [11:20am]
+* @Modified: October 18th, 2026 [11:20am]
+* @Version:  1.0.0
+*
+* Copyright (C) 2019 by Ben Sokol. All Rights Reserved.
+*/
+
+#ifndef BATTLESHIPRANDOM_HPP
+#define BATTLESHIPRANDOM_HPP
+
+#include <cstdint>
+#include <limits>
+
+// splitmix64. The whole state is one word, so it is cheap to keep per player and to checkpoint.
+class BattleshipRandom {
+public:
+  typedef uint64_t result_type;
+
+  explicit BattleshipRandom(uint64_t aSeed = 0) : mState(aSeed) {}
+
+  static constexpr result_type min() {
+    return 0;
+  }
+  static constexpr result_type max() {
+    return std::numeric_limits<result_type>::max();
+  }
+
+  result_type operator()() {
+    mState += 0x9e3779b97f4a7c15ULL;
+    return mix(mState);
+  }
+
+  uint64_t getState() const {
+    return mState;
+  }
+  void setState(uint64_t aState) {
+    mState = aState;
+  }
+
+  // Derives independent seeds, e.g. hash(seed, playerNum)
+  static uint64_t hash(uint64_t a, uint64_t b) {
+    return mix(a ^ mix(b + 0x9e3779b97f4a7c15ULL));
+  }
+
+private:
+  static uint64_t mix(uint64_t z) {
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+  }
+
+  uint64_t mState;
+};
+
+#endif
@@ -0,0 +1,195 @@
+/**
+* @Filename: BattleshipSweep.cpp
+* @Author:   Ben Sokol <Ben>
+* @Email:    ben@bensokol.com
+* @Created:  October 19th, 2026 [12:15am]
+* @Modified: October 19th, 2026 [12:15am]
+* @Version:  1.0.0
+*
+* Copyright (C) 2019 by Ben Sokol. All Rights Reserved.
+*/
+
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "UTL_inputValidation.hpp"
+
+#include "BattleshipSweep.hpp"
+
+
+namespace {
+  const char *const REPEAT_KEY = "repeat";
+
+  std::string trim(const std::string &aText) {
+    const size_t begin = aText.find_first_not_of(" \t\r");
+    if (begin == std::string::npos) {
+      return "";
+    }
+    return aText.substr(begin, aText.find_last_not_of(" \t\r") - begin + 1);
+  }
+
+  // Names and keys are written into every CSV and JSON row as they are, so they never need quoting
+  bool isName(const std::string &aText) {
+    return !aText.empty() && std::all_of(aText.begin(), aText.end(), [](char c) {
+      return std::isalnum(static_cast<unsigned char>(c)) || c == '-' || c == '_' || c == '.';
+    });
+  }
+}  // namespace
+
+
+BattleshipSweep::BattleshipSweep() {
+}
+
+
+/****************************************************************
+* load:
+*   Returns nullptr and sets aError, with the line, if aFile can
+*   not be read or is not laid out as a scenario file.
+****************************************************************/
+std::unique_ptr<BattleshipSweep> BattleshipSweep::load(const std::string &aFile, std::string &aError) {
+  std::ifstream file(aFile);
+  if (!file.is_open()) {
+    aError = "Unable to open scenario file " + aFile;
+    return nullptr;
+  }
+
+  // sections[0] holds the lines before the first [name]
+  std::vector<std::pair<std::string, grid_t>> sections(1);
+  std::string line;
+  for (size_t lineNum = 1; std::getline(file, line); ++lineNum) {
+    const std::string where = aFile + ":" + std::to_string(lineNum) + ": ";
+    line = trim(line.substr(0, line.find('#')));
+    if (line.empty()) {
+      continue;
+    }
+
+    if (line.front() == '[') {
+      const std::string name = trim(line.substr(1, line.size() - 2));
+      if (line.back() != ']' || !isName(name)) {
+        aError = where + "Expected [name], of letters, digits, '-', '_' and '.'";
+        return nullptr;
+      }
+      for (const auto &section : sections) {
+        if (section.first == name) {
+          aError = where + "Scenario " + name + " is already defined";
+          return nullptr;
+        }
+      }
+      sections.emplace_back(name, grid_t());
+      continue;
+    }
+
+    const size_t equals = line.find('=');
+    const std::string key = trim(line.substr(0, equals));
+    if (equals == std::string::npos || !isName(key)) {
+      aError = where + "Expected key = value, value, ...";
+      return nullptr;
+    }
+    std::vector<std::string> values;
+    size_t begin = equals + 1;
+    while (begin <= line.size()) {
+      const size_t end = std::min(line.find(',', begin), line.size());
+      values.push_back(trim(line.substr(begin, end - begin)));
+      if (values.back().empty()) {
+        aError = where + "Empty value for " + key;
+        return nullptr;
+      }
+      begin = end + 1;
+    }
+
+    grid_t &grid = sections.back().second;
+    if (std::find_if(grid.begin(), grid.end(), [&key](const grid_t::value_type &v) { return v.first == key; })
+        != grid.end()) {
+      aError = where + key + " is already given";
+      return nullptr;
+    }
+    grid.emplace_back(key, std::move(values));
+  }
+
+  // A file without sections is one grid
+  if (sections.size() == 1) {
+    sections.emplace_back("default", grid_t());
+  }
+
+  std::unique_ptr<BattleshipSweep> sweep(new BattleshipSweep());
+  for (size_t i = 1; i < sections.size(); ++i) {
+    // A section's keys replace the shared ones in place, and new keys go last
+    grid_t grid = sections[0].second;
+    for (auto &axis : sections[i].second) {
+      auto shared = std::find_if(grid.begin(), grid.end(),
+                                 [&axis](const grid_t::value_type &v) { return v.first == axis.first; });
+      if (shared != grid.end()) {
+        shared->second = axis.second;
+      }
+      else {
+        grid.push_back(axis);
+      }
+    }
+
+    size_t repeat = 1;
+    auto repeatAxis = std::find_if(grid.begin(), grid.end(),
+                                   [](const grid_t::value_type &v) { return v.first == REPEAT_KEY; });
+    if (repeatAxis != grid.end()) {
+      if (repeatAxis->second.size() != 1 || !UTL::isNumber(repeatAxis->second[0], 1)) {
+        aError = "Scenario " + sections[i].first + ": repeat must be a single count of at least 1";
+        return nullptr;
+      }
+      repeat = std::stoull(repeatAxis->second[0]);
+      grid.erase(repeatAxis);
+    }
+    sweep->addScenario(sections[i].first, grid, repeat);
+  }
+  return sweep;
+}
+
+
+const std::string &BattleshipSweep::getScenarioName(size_t aScenario) const {
+  return mScenarioNames[aScenario];
+}
+
+
+const std::vector<BattleshipSweep::point_t> &BattleshipSweep::getPoints() const {
+  return mPoints;
+}
+
+
+const std::vector<BattleshipSweep::run_t> &BattleshipSweep::getRuns() const {
+  return mRuns;
+}
+
+
+/****************************************************************
+* addScenario:
+*   The last key varies fastest, as if each key were a loop nested
+*   inside the one before it.
+****************************************************************/
+void BattleshipSweep::addScenario(const std::string &aName, const grid_t &aGrid, size_t aRepeat) {
+  const size_t scenario = mScenarioNames.size();
+  mScenarioNames.push_back(aName);
+
+  std::vector<size_t> index(aGrid.size(), 0);
+  while (true) {
+    point_t point = { scenario, values_t() };
+    for (size_t k = 0; k < aGrid.size(); ++k) {
+      point.values.emplace_back(aGrid[k].first, aGrid[k].second[index[k]]);
+    }
+    for (size_t repeat = 0; repeat < aRepeat; ++repeat) {
+      mRuns.push_back({ mPoints.size(), repeat });
+    }
+    mPoints.push_back(std::move(point));
+
+    size_t k = aGrid.size();
+    while (k > 0 && ++index[k - 1] == aGrid[k - 1].second.size()) {
+      index[k - 1] = 0;
+      --k;
+    }
+    if (k == 0) {
+      return;
+    }
+  }
+}
@@ -0,0 +1,58 @@
+/**
+* @Filename: BattleshipSweep.hpp
+* @Author:   Ben Sokol <Ben>
+* @Email:    ben@bensokol.com
+* @Created:  October 19th, 2026 [12:15am]
+* @Modified: October 19th, 2026 [12:15am]
+* @Version:  1.0.0
+*
+* Copyright (C) 2019 by Ben Sokol. All Rights Reserved.
+*/
+
+#ifndef BATTLESHIPSWEEP_HPP
+#define BATTLESHIPSWEEP_HPP
+
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Scenario files for --sweep. A file is a list of [name] sections, each a grid of "key = value, value, ..." lines,
+// and every combination of a section's values is a point that is played repeat times. Lines before the first section
+// are shared by every section, which may override them, and a file without sections is a single grid named default.
+// Anything after a # is a comment. Only the layout is checked here, the keys are given meaning by Battleship_Sweep.cpp.
+class BattleshipSweep {
+public:
+  typedef std::vector<std::pair<std::string, std::string>> values_t;
+
+  struct point_t {
+    size_t scenario;
+    values_t values;  // one per key, in the order the keys were first given
+  };
+
+  struct run_t {
+    size_t point;
+    size_t repeat;  // 0 to repeat - 1
+  };
+
+  static std::unique_ptr<BattleshipSweep> load(const std::string &aFile, std::string &aError);
+
+  const std::string &getScenarioName(size_t aScenario) const;
+  const std::vector<point_t> &getPoints() const;
+  // Every point's repeats in turn, in file order
+  const std::vector<run_t> &getRuns() const;
+
+private:
+  typedef std::vector<std::pair<std::string, std::vector<std::string>>> grid_t;
+
+  BattleshipSweep();
+
+  void addScenario(const std::string &aName, const grid_t &aGrid, size_t aRepeat);
+
+  std::vector<std::string> mScenarioNames;
+  std::vector<point_t> mPoints;
+  std::vector<run_t> mRuns;
+};
+
+#endif
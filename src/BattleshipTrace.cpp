@@ -0,0 +1,194 @@
+/**
+* @Filename: BattleshipTrace.cpp
+* @Author:   Ben Sokol <Ben>
+* @Email:    ben@bensokol.com
+* @Created:  October 18th, 2026 [3:51pm]
+* @Modified: October 19th, 2026 [2:05am]
+* @Version:  1.0.0
+*
+* Copyright (C) 2019 by Ben Sokol. All Rights Reserved.
+*/
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "BattleshipAllocations.hpp"
+#include "BattleshipTrace.hpp"
+
+
+namespace {
+  struct event_t {
+    const char *name;
+    uint64_t begin;
+    uint64_t end;
+  };
+
+  const std::chrono::steady_clock::time_point gEpoch = std::chrono::steady_clock::now();
+}  // namespace
+
+
+struct BattleshipTrace::buffer_t {
+  size_t tid = 0;
+  std::string name;
+  std::vector<event_t> events;
+  size_t dropped = 0;
+
+  // Sampling state of the owning thread
+  size_t depth = 0;
+  size_t outermostSpans = 0;
+  bool sampled = false;
+};
+
+
+std::atomic<bool> BattleshipTrace::sEnabled(false);
+size_t BattleshipTrace::sSampleEvery = 1;
+size_t BattleshipTrace::sMaxEventsPerThread = 0;
+std::mutex BattleshipTrace::sBuffersMtx;
+std::vector<std::unique_ptr<BattleshipTrace::buffer_t>> BattleshipTrace::sBuffers;
+
+
+BattleshipTrace::Span::Span(const char *aName) : mBuffer(nullptr), mName(aName), mBegin(0) {
+  if (!sEnabled.load(std::memory_order_relaxed)) {
+    return;
+  }
+
+  mBuffer = &getBuffer();
+  if (mBuffer->depth++ == 0) {
+    mBuffer->sampled = (mBuffer->outermostSpans++ % sSampleEvery) == 0;
+  }
+  if (mBuffer->sampled) {
+    mBegin = now();
+  }
+}
+
+
+BattleshipTrace::Span::~Span() {
+  if (!mBuffer) {
+    return;
+  }
+
+  mBuffer->depth--;
+  if (mBegin == 0) {
+    return;
+  }
+  if (mBuffer->events.size() >= sMaxEventsPerThread) {
+    mBuffer->dropped++;
+    return;
+  }
+  mBuffer->events.push_back({ mName, mBegin, now() });
+}
+
+
+void BattleshipTrace::start(size_t aSampleEvery, size_t aMaxEventsPerThread) {
+  sSampleEvery = aSampleEvery > 0 ? aSampleEvery : 1;
+  sMaxEventsPerThread = aMaxEventsPerThread;
+  sEnabled.store(true);
+}
+
+
+void BattleshipTrace::stop() {
+  sEnabled.store(false);
+}
+
+
+bool BattleshipTrace::isEnabled() {
+  return sEnabled.load(std::memory_order_relaxed);
+}
+
+
+void BattleshipTrace::setThreadName(const std::string &aName) {
+  buffer_t &buffer = getBuffer();
+  std::lock_guard<std::mutex> lck(sBuffersMtx);
+  buffer.name = aName;
+}
+
+
+/****************************************************************
+* write:
+*   Writes every buffer as complete ("X") events, timestamps are
+*   in microseconds. Call once every traced thread is idle.
+****************************************************************/
+bool BattleshipTrace::write(const std::string &aFile) {
+  std::FILE *file = std::fopen(aFile.c_str(), "w");
+  if (!file) {
+    return false;
+  }
+
+  std::lock_guard<std::mutex> lck(sBuffersMtx);
+  std::fprintf(file, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+  bool first = true;
+  for (auto &buffer : sBuffers) {
+    if (!buffer->name.empty()) {
+      std::fprintf(file, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":%zu,\"args\":{\"name\":\"%s\"}}",
+                   first ? "" : ",\n", buffer->tid, buffer->name.c_str());
+      first = false;
+    }
+    for (auto &event : buffer->events) {
+      std::fprintf(file, "%s{\"name\":\"%s\",\"ph\":\"X\",\"pid\":0,\"tid\":%zu,\"ts\":%.3f,\"dur\":%.3f}",
+                   first ? "" : ",\n", event.name, buffer->tid, static_cast<double>(event.begin) / 1000.0,
+                   static_cast<double>(event.end - event.begin) / 1000.0);
+      first = false;
+    }
+  }
+  std::fprintf(file, "\n]}\n");
+  return std::fclose(file) == 0;
+}
+
+
+size_t BattleshipTrace::getEventCount() {
+  std::lock_guard<std::mutex> lck(sBuffersMtx);
+  size_t count = 0;
+  for (auto &buffer : sBuffers) {
+    count += buffer->events.size();
+  }
+  return count;
+}
+
+
+size_t BattleshipTrace::getBufferBytes() {
+  std::lock_guard<std::mutex> lck(sBuffersMtx);
+  size_t bytes = 0;
+  for (auto &buffer : sBuffers) {
+    bytes += sizeof(buffer_t) + buffer->events.size() * sizeof(event_t);
+  }
+  return bytes;
+}
+
+
+size_t BattleshipTrace::getDroppedCount() {
+  std::lock_guard<std::mutex> lck(sBuffersMtx);
+  size_t count = 0;
+  for (auto &buffer : sBuffers) {
+    count += buffer->dropped;
+  }
+  return count;
+}
+
+
+BattleshipTrace::buffer_t &BattleshipTrace::getBuffer() {
+  thread_local buffer_t *tBuffer = nullptr;
+  if (!tBuffer) {
+    BattleshipAllocations::Allow allow;
+    std::lock_guard<std::mutex> lck(sBuffersMtx);
+    sBuffers.emplace_back(new buffer_t);
+    tBuffer = sBuffers.back().get();
+    tBuffer->tid = sBuffers.size() - 1;
+    // Reserved whole, so recording a span never allocates. Only the pages that are filled become resident.
+    tBuffer->events.reserve(sMaxEventsPerThread);
+  }
+  return *tBuffer;
+}
+
+
+uint64_t BattleshipTrace::now() {
+  // Never 0, which marks a span that was not recorded
+  return static_cast<uint64_t>(
+             std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - gEpoch).count())
+         + 1;
+}
@@ -0,0 +1,69 @@
+/**
+* @Filename: BattleshipTrace.hpp
+* @Author:   Ben Sokol <Ben>
+* @Email:    ben@bensokol.com
+* @Created:  October 18th, 2026 [3:51pm]
+* @Modified: October 19th, 2026 [2:05am]
+* @Version:  1.0.0
+*
+* Copyright (C) 2019 by Ben Sokol. All Rights Reserved.
+*/
+
+#ifndef BATTLESHIPTRACE_HPP
+#define BATTLESHIPTRACE_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Span tracing in Chrome trace-event format (chrome://tracing, ui.perfetto.dev). Every thread records into its own
+// buffer, so a span costs two clock reads and an append, and a single relaxed load when tracing is off.
+class BattleshipTrace {
+  struct buffer_t;
+
+public:
+  // Records the lifetime of the span. Span names must be string literals.
+  class Span {
+  public:
+    explicit Span(const char *aName);
+    ~Span();
+    Span(const Span &) = delete;
+    Span &operator=(const Span &) = delete;
+
+  private:
+    buffer_t *mBuffer;  // nullptr if tracing was off
+    const char *mName;
+    uint64_t mBegin;
+  };
+
+  // Only one outermost span in every aSampleEvery is recorded per thread, nested spans follow their outermost span
+  static void start(size_t aSampleEvery = 1, size_t aMaxEventsPerThread = 1 << 22);
+  static void stop();
+  static bool isEnabled();
+
+  static void setThreadName(const std::string &aName);
+
+  static bool write(const std::string &aFile);
+  static size_t getEventCount();
+  static size_t getDroppedCount();
+  // Buffers are reserved for aMaxEventsPerThread up front, only the filled part is resident and counted
+  static size_t getBufferBytes();
+
+private:
+  static buffer_t &getBuffer();
+  static uint64_t now();
+
+  static std::atomic<bool> sEnabled;
+  static size_t sSampleEvery;
+  static size_t sMaxEventsPerThread;
+
+  // Buffers are owned here, so they outlive the threads that filled them
+  static std::mutex sBuffersMtx;
+  static std::vector<std::unique_ptr<buffer_t>> sBuffers;
+};
+
+#endif
@@ -0,0 +1,131 @@
+/**
+* @Filename: BattleshipView.cpp
+* @Author:   Ben Sokol <Ben>
+* @Email:    ben@bensokol.com
+* @Created:  October 18th, 2026 [10:55pm]
+* @Modified: October 18th, 2026 [10:55pm]
+* @Version:  1.0.0
+*
+* Copyright (C) 2019 by Ben Sokol. All Rights Reserved.
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "UTL_colors.h"
+
+#include "BattleshipView.hpp"
+
+
+namespace {
+  const char CELLS[4] = { '_', 'O', '.', '*' };
+
+  // Labels take the first row, boards start on the second, with a gap between boards
+  const size_t FIRST_ROW = 2;
+  const size_t LABEL_WIDTH = 24;
+  const size_t GAP = 2;
+  const size_t NO_INDEX = static_cast<size_t>(-1);
+
+  void moveTo(std::string &aFrame, size_t aRow, size_t aCol) {
+    aFrame += "\033[" + std::to_string(aRow) + ";" + std::to_string(aCol) + "H";
+  }
+
+  const char *colorOf(uint8_t aCode) {
+    return aCode == 3 ? UTL::COLOR_RED_BOLD : (aCode == 1 ? UTL::COLOR_GREEN_BOLD : UTL::COLOR_RESET);
+  }
+}  // namespace
+
+
+BattleshipView::board_t::board_t(size_t aPlayer, size_t aSize, size_t aLeft)
+    : mPlayer(aPlayer), mSize(aSize), mLeft(aLeft), mCodes(aSize * aSize), mDirty((aSize * aSize + 63) / 64) {
+  for (auto &code : mCodes) {
+    code.store(0, std::memory_order_relaxed);
+  }
+  for (auto &dirty : mDirty) {
+    dirty.store(0, std::memory_order_relaxed);
+  }
+}
+
+
+BattleshipView::BattleshipView() : mWidth(0) {}
+
+
+BattleshipView::board_t &BattleshipView::watch(size_t aPlayer, size_t aSize) {
+  mBoards.push_back(std::unique_ptr<board_t>(new board_t(aPlayer, aSize, mWidth + 1)));
+  mWidth += std::max(aSize, LABEL_WIDTH) + GAP;
+  return *mBoards.back();
+}
+
+
+size_t BattleshipView::getBoardCount() const {
+  return mBoards.size();
+}
+
+
+BattleshipView::board_t &BattleshipView::getBoard(size_t aBoard) {
+  return *mBoards[aBoard];
+}
+
+
+std::string BattleshipView::open() const {
+  return "\033[?1049h\033[?25l\033[2J";
+}
+
+
+std::string BattleshipView::close() const {
+  return std::string(UTL::COLOR_RESET) + "\033[?25h\033[?1049l";
+}
+
+
+void BattleshipView::drawLabel(std::string &aFrame, size_t aBoard, const std::string &aLabel) const {
+  const board_t &board = *mBoards[aBoard];
+  const size_t width = std::max(board.mSize, LABEL_WIDTH);
+  moveTo(aFrame, 1, board.mLeft);
+  aFrame += UTL::COLOR_RESET;
+  aFrame += aLabel.substr(0, width);
+  aFrame += std::string(width - std::min(width, aLabel.size()), ' ');
+}
+
+
+/****************************************************************
+* drawFrame:
+*   Cells come out in row-major order, so the cursor only has to be
+*   moved at a gap or the start of a row, and the color only when
+*   it changes. A cell marked while the frame is drawn keeps its
+*   dirty bit, or has it set again, and is drawn next frame.
+****************************************************************/
+size_t BattleshipView::drawFrame(std::string &aFrame) {
+  size_t cells = 0;
+  const char *color = nullptr;
+  for (auto &board : mBoards) {
+    size_t cursor = NO_INDEX;
+    for (size_t word = 0; word < board->mDirty.size(); ++word) {
+      if (board->mDirty[word].load(std::memory_order_relaxed) == 0) {
+        continue;
+      }
+      uint64_t bits = board->mDirty[word].exchange(0, std::memory_order_acquire);
+      while (bits != 0) {
+        const size_t index = word * 64 + static_cast<size_t>(__builtin_ctzll(bits));
+        bits &= bits - 1;
+
+        if (index != cursor || index % board->mSize == 0) {
+          moveTo(aFrame, FIRST_ROW + index / board->mSize, board->mLeft + index % board->mSize);
+        }
+        const uint8_t code = board->mCodes[index].load(std::memory_order_relaxed) & 3;
+        if (colorOf(code) != color) {
+          color = colorOf(code);
+          aFrame += color;
+        }
+        aFrame += CELLS[code];
+        cursor = index + 1;
+        cells++;
+      }
+    }
+  }
+  return cells;
+}
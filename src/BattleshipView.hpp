@@ -0,0 +1,72 @@
+/**
+* @Filename: BattleshipView.hpp
+* @Author:   Ben Sokol <Ben>
+* @Email:    ben@bensokol.com
+* @Created:  October 18th, 2026 [10:55pm]
+* @Modified: October 18th, 2026 [10:55pm]
+* @Version:  1.0.0
+*
+* Copyright (C) 2019 by Ben Sokol. All Rights Reserved.
+*/
+
+#ifndef BATTLESHIPVIEW_HPP
+#define BATTLESHIPVIEW_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Live terminal view of a few boards. A watched board reports every cell it changes with mark, which stores the
+// cell's code and sets its dirty bit without taking a lock. drawFrame swaps out the dirty words and emits only those
+// cells with ANSI cursor moves, so a frame costs the cells that changed rather than every cell of every board.
+class BattleshipView {
+public:
+  class board_t {
+  public:
+    board_t(size_t aPlayer, size_t aSize, size_t aLeft);
+
+    // aCode as in a checkpoint, 0 '_', 1 'O', 2 '.' or 3 '*'. Called with the board's player locked.
+    void mark(size_t aIndex, uint8_t aCode) {
+      mCodes[aIndex].store(aCode, std::memory_order_relaxed);
+      mDirty[aIndex / 64].fetch_or(uint64_t(1) << (aIndex % 64), std::memory_order_release);
+    }
+
+    size_t getPlayer() const {
+      return mPlayer;
+    }
+
+  private:
+    friend class BattleshipView;
+
+    const size_t mPlayer;
+    const size_t mSize;
+    const size_t mLeft;  // first screen column
+    std::vector<std::atomic<uint8_t>> mCodes;
+    std::vector<std::atomic<uint64_t>> mDirty;  // a bit per cell, row-major
+  };
+
+  BattleshipView();
+
+  // Boards are laid out left to right, watch them all before the first frame
+  board_t &watch(size_t aPlayer, size_t aSize);
+  size_t getBoardCount() const;
+  board_t &getBoard(size_t aBoard);
+
+  // Switches to the alternate screen and clears it
+  std::string open() const;
+  // Returns to the normal screen
+  std::string close() const;
+  // The line above board aBoard, cut or padded to its width
+  void drawLabel(std::string &aFrame, size_t aBoard, const std::string &aLabel) const;
+  // Every cell marked since the last frame, returns how many were drawn
+  size_t drawFrame(std::string &aFrame);
+
+private:
+  std::vector<std::unique_ptr<board_t>> mBoards;
+  size_t mWidth;
+};
+
+#endif
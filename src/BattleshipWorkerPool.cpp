@@ -0,0 +1,94 @@
+/**
+* @Filename: BattleshipWorkerPool.cpp
+* @Author:   Ben Sokol <Ben>
+* @Email:    ben@bensokol.com
+* @Created:  October 18th, 2026 [1:05pm]
+* @Modified: October 18th, 2026 [1:05pm]
+* @Version:  1.0.0
+*
+* Copyright (C) 2019 by Ben Sokol. All Rights Reserved.
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#include "UTL_assert.h"
+
+#include "BattleshipWorkerPool.hpp"
+
+
+BattleshipWorkerPool::BattleshipWorkerPool(size_t aWorkers)
+    : mJob(nullptr), mGeneration(0), mRunning(0), mStopping(false) {
+  UTL_assert(aWorkers > 0);
+  for (size_t i = 0; i < aWorkers; ++i) {
+    mWorkers.emplace_back(&BattleshipWorkerPool::workerLoop, this, i);
+  }
+}
+
+
+BattleshipWorkerPool::~BattleshipWorkerPool() {
+  {
+    std::lock_guard<std::mutex> lck(mMtx);
+    mStopping = true;
+  }
+  mStartCv.notify_all();
+  for (auto &worker : mWorkers) {
+    worker.join();
+  }
+}
+
+
+size_t BattleshipWorkerPool::size() const {
+  return mWorkers.size();
+}
+
+
+void BattleshipWorkerPool::runOnEach(const std::function<void(size_t)> &aFunction) {
+  std::unique_lock<std::mutex> lck(mMtx);
+  UTL_assert(mRunning == 0);
+  mJob = &aFunction;
+  mRunning = mWorkers.size();
+  mGeneration++;
+  mStartCv.notify_all();
+  mDoneCv.wait(lck, [this]() { return mRunning == 0; });
+  mJob = nullptr;
+}
+
+
+void BattleshipWorkerPool::parallelFor(size_t aCount, size_t aChunk, const std::function<void(size_t)> &aFunction) {
+  std::atomic<size_t> next(0);
+  aChunk = std::max<size_t>(aChunk, 1);
+  runOnEach([&](size_t) {
+    for (size_t begin = next.fetch_add(aChunk); begin < aCount; begin = next.fetch_add(aChunk)) {
+      const size_t end = std::min(begin + aChunk, aCount);
+      for (size_t i = begin; i < end; ++i) {
+        aFunction(i);
+      }
+    }
+  });
+}
+
+
+void BattleshipWorkerPool::workerLoop(size_t aWorker) {
+  size_t generation = 0;
+  std::unique_lock<std::mutex> lck(mMtx);
+  while (true) {
+    mStartCv.wait(lck, [&]() { return mStopping || mGeneration != generation; });
+    if (mStopping) {
+      return;
+    }
+    generation = mGeneration;
+    const std::function<void(size_t)> *job = mJob;
+
+    lck.unlock();
+    (*job)(aWorker);
+    lck.lock();
+
+    if (--mRunning == 0) {
+      mDoneCv.notify_all();
+    }
+  }
+}
@@ -0,0 +1,51 @@
+/**
+* @Filename: BattleshipWorkerPool.hpp
+* @Author:   Ben Sokol <Ben>
+* @Email:    ben@bensokol.com
+* @Created:  October 18th, 2026 [1:05pm]
+* @Modified: October 18th, 2026 [1:05pm]
+* @Version:  1.0.0
+*
+* Copyright (C) 2019 by Ben Sokol. All Rights Reserved.
+*/
+
+#ifndef BATTLESHIPWORKERPOOL_HPP
+#define BATTLESHIPWORKERPOOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdlib>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// A fixed set of threads that is started once and reused for every phase.
+class BattleshipWorkerPool {
+public:
+  explicit BattleshipWorkerPool(size_t aWorkers);
+  ~BattleshipWorkerPool();
+
+  size_t size() const;
+
+  // Runs aFunction(worker) once on every worker and waits for all of them
+  void runOnEach(const std::function<void(size_t)> &aFunction);
+
+  // Runs aFunction(i) for every i in [0, aCount), handing out aChunk indices at a time
+  void parallelFor(size_t aCount, size_t aChunk, const std::function<void(size_t)> &aFunction);
+
+private:
+  void workerLoop(size_t aWorker);
+
+  std::vector<std::thread> mWorkers;
+
+  std::mutex mMtx;
+  std::condition_variable mStartCv;
+  std::condition_variable mDoneCv;
+  const std::function<void(size_t)> *mJob;
+  size_t mGeneration;
+  size_t mRunning;
+  bool mStopping;
+};
+
+#endif
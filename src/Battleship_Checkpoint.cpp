@@ -0,0 +1,124 @@
+/**
+* @Filename: Battleship_Checkpoint.cpp
+* @Author:   Ben Sokol <Ben>
+* @Email:    ben@bensokol.com
+* @Created:  October 18th, 2026 [12:14pm]
+* @Modified: October 19th, 2026 [1:45am]
+* @Version:  1.0.0
+*
+* Copyright (C) 2019 by Ben Sokol. All Rights Reserved.
+*/
+
+#include <chrono>    // std::chrono
+#include <cstdlib>   // size_t
+#include <mutex>     // std::mutex, std::unique_lock, std::lock_guard
+#include <string>    // std::string
+
+#include "BattleshipCheckpoint.hpp"
+#include "TS_logAndPrint.hpp"
+#include "UTL_colors.h"
+
+#include "Battleship.hpp"
+
+
+/****************************************************************
+* loadCheckpoint:
+*   Maps mResumeFile and takes P, N, M, the seed and the revive
+*   count from it. Players are restored from the mapping in
+*   initPlayers.
+****************************************************************/
+bool Battleship::loadCheckpoint() {
+  std::string error;
+  mResume = BattleshipCheckpoint::load(mResumeFile, error);
+  if (!mResume) {
+    return invalidParameters(error);
+  }
+
+  const BattleshipCheckpoint::header_t &header = mResume->getHeader();
+  mNumThreads = header.players;
+  mSize = header.size;
+  mTargets = header.targets;
+  mSeed = header.seed;
+  mCheckpointSequence = header.sequence;
+  mRevives.store(header.revives);
+  return true;
+}
+
+
+/****************************************************************
+* checkpointLoop:
+*   Writes a checkpoint every mCheckpointInterval seconds until the
+*   battle is over. An attack changes both the attacker and the
+*   target, so players can not be copied while any turn is under
+*   way. Every worker is parked between turns for the copy, and the
+*   file is written once they are battling again.
+****************************************************************/
+void Battleship::checkpointLoop() {
+  BattleshipCheckpoint checkpoint(mNumThreads, mSize, mTargets, mSeed);
+
+  std::unique_lock<std::mutex> lck(mCheckpointMtx);
+  while (!mDone) {
+    mCheckpointCv.wait_for(lck, std::chrono::seconds(mCheckpointInterval), [this]() { return mDone.load(); });
+    if (mDone) {
+      break;
+    }
+
+    mCheckpointPending.store(true);
+    mCheckpointCv.wait(lck, [this]() { return mCheckpointParked == mNumWorkers; });
+    const bool capture = !mDone;
+    if (capture) {
+      captureCheckpoint(checkpoint);
+    }
+    mCheckpointPending.store(false);
+    lck.unlock();
+    mCheckpointCv.notify_all();
+
+    if (capture) {
+      writeCheckpoint(checkpoint);
+    }
+    lck.lock();
+  }
+}
+
+
+/****************************************************************
+* parkForCheckpoint:
+*   Called by a worker between turns, with no player locked. A
+*   worker leaving the battle stays counted as parked, so a
+*   checkpoint never waits for it.
+****************************************************************/
+void Battleship::parkForCheckpoint(bool aLeaving) {
+  std::unique_lock<std::mutex> lck(mCheckpointMtx);
+  mCheckpointParked++;
+  mCheckpointCv.notify_all();
+  if (aLeaving) {
+    return;
+  }
+  mCheckpointCv.wait(lck, [this]() { return !mCheckpointPending.load(); });
+  mCheckpointParked--;
+}
+
+
+/****************************************************************
+* captureCheckpoint:
+*   Caller must hold mCheckpointMtx with every worker parked.
+****************************************************************/
+void Battleship::captureCheckpoint(BattleshipCheckpoint &checkpoint) {
+  for (size_t i = 0; i < mNumThreads; ++i) {
+    BattleshipCheckpoint::record_t &record = checkpoint.getRecord(i);
+    mPlayers[i]->saveState(record.player, checkpoint.getInitialCells(i), checkpoint.getCurrentCells(i));
+    record.battleRngState = mRngs[i].getState();
+  }
+  checkpoint.setRevives(mRevives.load());
+}
+
+
+void Battleship::writeCheckpoint(BattleshipCheckpoint &checkpoint) {
+  if (checkpoint.write(mCheckpointFile, ++mCheckpointSequence)) {
+    logAndPrint("Wrote checkpoint ", mCheckpointSequence, ".\n");
+  }
+  else {
+    logAndPrintAlways(UTL::COLOR_PURPLE_BOLD, "Warning", UTL::COLOR_RESET, ": Unable to write checkpoint ",
+                      mCheckpointFile, "\n");
+  }
+}
@@ -0,0 +1,98 @@
+/**
+* @Filename: Battleship_Counters.cpp
+* @Author:   Ben Sokol <Ben>
+* @Email:    ben@bensokol.com
+* @Created:  October 18th, 2026 [3:12pm]
+* @Modified: October 18th, 2026 [3:12pm]
+* @Version:  1.0.0
+*
+* Copyright (C) 2019 by Ben Sokol. All Rights Reserved.
+*/
+
+#include <cstdlib>  // size_t
+#include <memory>   // std::unique_ptr
+#include <string>   // std::string, std::to_string
+#include <vector>   // std::vector
+
+#include "BattleshipCounters.hpp"
+
+#include "Battleship.hpp"
+
+
+/****************************************************************
+* openCounters:
+*   Counters follow a single thread, so every worker opens its
+*   own.
+****************************************************************/
+void Battleship::openCounters() {
+  mCounters = std::vector<std::unique_ptr<BattleshipCounters>>(mNumWorkers);
+  mPool->runOnEach([this](size_t worker) { mCounters[worker].reset(new BattleshipCounters()); });
+}
+
+
+void Battleship::startCounters() {
+  for (auto &counters : mCounters) {
+    counters->start();
+  }
+}
+
+
+void Battleship::stopCounters(std::vector<BattleshipCounters::sample_t> &samples) {
+  samples.clear();
+  for (auto &counters : mCounters) {
+    samples.push_back(counters->stop());
+  }
+}
+
+
+/****************************************************************
+* generateCountersReport:
+*   Caller must hold the COUT and LOG mutexes.
+****************************************************************/
+void Battleship::generateCountersReport() {
+  mReport += "\nHardware Counters:\n";
+  if (mCounters.empty() || !mCounters[0]->isOpen()) {
+    mReport += "  Unavailable: " + (mCounters.empty() ? std::string("not measured") : mCounters[0]->getError()) + "\n";
+    return;
+  }
+  if (!mCounters[0]->getError().empty()) {
+    mReport += "  Some counters are unavailable: " + mCounters[0]->getError() + "\n";
+  }
+
+  const std::vector<BattleshipCounters::sample_t> *phases[] = { &mInitSamples, &mBattleSamples };
+  const char *phaseNames[] = { "Initial Phase", "Battle Phase" };
+  for (size_t phase = 0; phase < 2; ++phase) {
+    BattleshipCounters::sample_t total;
+    for (auto &sample : *phases[phase]) {
+      total += sample;
+    }
+
+    mReport += "  " + std::string(phaseNames[phase]) + ":\n";
+    for (size_t i = 0; i < BattleshipCounters::COUNTER_COUNT; ++i) {
+      const std::string name = std::string(BattleshipCounters::getName(i)) + ":";
+      mReport += "    " + name + std::string(18 - name.size(), ' ');
+      mReport += total.valid[i] ? std::to_string(total.value[i]) : std::string("n/a");
+      mReport += "\n";
+    }
+    if (total.valid[BattleshipCounters::CYCLES] && total.valid[BattleshipCounters::INSTRUCTIONS]
+        && total.value[BattleshipCounters::CYCLES] > 0) {
+      mReport += "    Instructions per Cycle: "
+                 + std::to_string(static_cast<double>(total.value[BattleshipCounters::INSTRUCTIONS])
+                                  / static_cast<double>(total.value[BattleshipCounters::CYCLES]))
+                 + "\n";
+    }
+  }
+
+  // Per worker battle counters show imbalance and contention between workers
+  mReport += "  Battle Phase per Worker:\n";
+  for (size_t worker = 0; worker < mBattleSamples.size(); ++worker) {
+    const BattleshipCounters::sample_t &sample = mBattleSamples[worker];
+    mReport += "    Worker " + std::to_string(worker) + ":";
+    for (size_t i = 0; i < BattleshipCounters::COUNTER_COUNT; ++i) {
+      mReport += (i == 0 ? " " : ", ");
+      mReport += sample.valid[i] ? std::to_string(sample.value[i]) : std::string("n/a");
+      mReport += " " + std::string(BattleshipCounters::getName(i));
+    }
+    mReport += "\n";
+  }
+}
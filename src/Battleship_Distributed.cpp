@@ -0,0 +1,288 @@
+/**
+* @Filename: Battleship_Distributed.cpp
+* @Author:   Ben Sokol <Ben>
+* @Email:    ben@bensokol.com
+* @Created:  October 18th, 2026 [10:31am]
+* @Modified: October 19th, 2026 [2:20am]
+* @Version:  1.0.0
+*
+* Copyright (C) 2019 by Ben Sokol. All Rights Reserved.
+*/
+
+#include <chrono>    // std::chrono
+#include <cstdlib>   // size_t
+#include <iostream>  // std::cout
+#include <mutex>     // std::mutex, std::unique_lock, std::lock_guard
+#include <string>    // std::string, std::to_string
+
+#include "BattleshipNetwork.hpp"
+#include "TS_logAndPrint.hpp"
+#include "UTL_assert.h"
+#include "UTL_colors.h"
+
+#include "Battleship.hpp"
+
+// Remote attacks a player may have outstanding before it waits for results
+static const size_t MAX_REMOTE_ATTACKS_IN_FLIGHT = 8;
+
+// Node 0 owns the global live count and decides when the battle is over
+static const size_t COORDINATOR_NODE = 0;
+
+
+/****************************************************************
+* startNetwork:
+*   Connects to every other node. All peers have initialized
+*   their players once this returns.
+****************************************************************/
+bool Battleship::startNetwork() {
+  logAndPrintAlways("Connecting to ", mNetwork->getNodeCount() - 1, " nodes as node ", mNodeId, " (players ",
+                    mLocalBegin, " to ", mLocalEnd - 1, ")...\n");
+  if (!mNetwork->start(
+          [this](size_t node, const BattleshipNetwork::message_t &message) { handleMessage(node, message); })) {
+    std::cout << UTL::COLOR_RED_BOLD << "ERROR" << UTL::COLOR_RESET << ": " << mNetwork->getError() << "\n";
+    return false;
+  }
+  logAndPrintAlways("Connected.\n");
+  return true;
+}
+
+
+bool Battleship::isLocalPlayer(size_t playerNum) const {
+  return playerNum >= mLocalBegin && playerNum < mLocalEnd;
+}
+
+
+size_t Battleship::nodeOfPlayer(size_t playerNum) const {
+  // Inverse of the shard boundaries computed in the constructor
+  return ((playerNum + 1) * mPeers.size() - 1) / mNumThreads;
+}
+
+
+/****************************************************************
+* battleDistributedTurn:
+*   Same rules as battleTurn, but opponents may live on other
+*   nodes. Remote attacks are queued on the network and their
+*   results arrive through handleMessage.
+****************************************************************/
+bool Battleship::battleDistributedTurn(size_t playerNum) {
+  BattleshipRandom &rng = mRngs[playerNum];
+  std::unique_lock<std::mutex> playerLck(mPlayerMtx[playerNum]);
+
+  // Dead players wait to be revived, busy players wait for their remote results
+  if (!mPlayers[playerNum]->isAlive() || mInFlight[playerNum].load() >= MAX_REMOTE_ATTACKS_IN_FLIGHT) {
+    return false;
+  }
+
+  // Get a random opponent that is still alive according to this node's view
+  bool foundTarget = false;
+  size_t target = rng() % mNumThreads;
+  for (size_t i = 0; i < mNumThreads; ++i) {
+    if (target != playerNum && mAliveView[target].load()) {
+      foundTarget = true;
+      break;
+    }
+    target = (target + 1) % mNumThreads;
+  }
+
+  // The coordinator announces the winner, wait for it
+  if (!foundTarget) {
+    return false;
+  }
+
+  // Revives are only made on this node, but shouldRevive counts every node's players
+  if (shouldRevive(mAliveCount.load(), mNumThreads, rng)) {
+    size_t reviveTarget = mLocalBegin + rng() % (mLocalEnd - mLocalBegin);
+    for (size_t i = mLocalBegin; i < mLocalEnd; ++i) {
+      if (reviveTarget != playerNum && !mPlayers[reviveTarget]->isAlive()) {
+        revivePlayer(reviveTarget);
+        logAndPrint("Player ", reviveTarget, " has been revived.\n");
+        syncStatus(reviveTarget);
+        handOffRevived(reviveTarget);
+        break;
+      }
+      reviveTarget = (reviveTarget + 1 < mLocalEnd) ? reviveTarget + 1 : mLocalBegin;
+    }
+  }
+
+  recordReviveLatency(playerNum);
+  if (isLocalPlayer(target)) {
+    // The cell is chosen and attacked under one lock of the target, as the network thread may be attacking it too
+    if (mPlayers[playerNum]->launchAttacks(*mPlayers[target], 1) > 0) {
+      logAndPrint("Player ", playerNum, " attacked player ", target, ".\n");
+      syncStatus(target);
+    }
+  }
+  else {
+    // The target's node picks the location, the result comes back as MESSAGE_RESULT
+    logAndPrint("Player ", playerNum, " is attacking player ", target, " on node ", nodeOfPlayer(target), ".\n");
+    mInFlight[playerNum]++;
+    BattleshipNetwork::message_t message = { BattleshipNetwork::MESSAGE_ATTACK, static_cast<uint32_t>(playerNum),
+                                             static_cast<uint32_t>(target), 0 };
+    mNetwork->send(nodeOfPlayer(target), message);
+  }
+  return true;
+}
+
+
+/****************************************************************
+* handleMessage:
+*   Runs on the network event loop.
+****************************************************************/
+void Battleship::handleMessage(size_t node, const BattleshipNetwork::message_t &message) {
+  switch (message.type) {
+    case BattleshipNetwork::MESSAGE_ATTACK: {
+      // value stays COUNT if the target can no longer be attacked
+      BattleshipNetwork::message_t reply = { BattleshipNetwork::MESSAGE_RESULT, message.player, message.target,
+                                             BattleshipBoard::COUNT };
+      if (!mDone && isLocalPlayer(message.target)) {
+        // A single shot salvo, so no local worker can pick the same cell between choosing and attacking it
+        BattleshipBoard::attackCounts_t counts;
+        if (mPlayers[message.target]->receiveSalvo(message.player, 1, counts) > 0) {
+          for (size_t result = 0; result < BattleshipBoard::COUNT; ++result) {
+            if (counts.results[result] > 0) {
+              reply.value = static_cast<uint32_t>(result);
+            }
+          }
+          syncStatus(message.target);
+        }
+      }
+      mNetwork->send(node, reply);
+      break;
+    }
+
+    case BattleshipNetwork::MESSAGE_RESULT: {
+      if (!isLocalPlayer(message.player)) {
+        break;
+      }
+      if (message.value < BattleshipBoard::COUNT) {
+        mPlayers[message.player]->recordAttackLaunched(static_cast<BattleshipBoard::ATTACK_RESULT>(message.value));
+      }
+      mInFlight[message.player]--;
+      mCvs[workerOfPlayer(message.player)].notify_all();
+      break;
+    }
+
+    case BattleshipNetwork::MESSAGE_STATUS: {
+      std::lock_guard<std::mutex> lck(mStatusMtx);
+      if (message.target < mNumThreads && !isLocalPlayer(message.target)
+          && mAliveView[message.target].load() != (message.value != 0)) {
+        setStatus(message.target, message.value != 0);
+      }
+      break;
+    }
+
+    case BattleshipNetwork::MESSAGE_DONE: {
+      if (message.value < mNumThreads) {
+        finishBattle(message.value);
+      }
+      break;
+    }
+
+    // BattleshipNetwork closes the link on any other type
+    default:
+      UTL_assert_always();
+      break;
+  }
+}
+
+
+/****************************************************************
+* syncStatus:
+*   Publishes a local player's liveness if it changed. The view is
+*   reread under mStatusMtx, so concurrent attacks and revives
+*   always leave the last published state correct.
+****************************************************************/
+void Battleship::syncStatus(size_t playerNum) {
+  std::lock_guard<std::mutex> lck(mStatusMtx);
+  const bool alive = mPlayers[playerNum]->isAlive();
+  if (mAliveView[playerNum].load() == alive) {
+    return;
+  }
+
+  BattleshipNetwork::message_t message = { BattleshipNetwork::MESSAGE_STATUS, static_cast<uint32_t>(mNodeId),
+                                           static_cast<uint32_t>(playerNum), alive ? 1u : 0u };
+  mNetwork->broadcast(message);
+  setStatus(playerNum, alive);
+}
+
+
+/****************************************************************
+* setStatus:
+*   Caller must hold mStatusMtx.
+****************************************************************/
+void Battleship::setStatus(size_t playerNum, bool alive) {
+  mAliveView[playerNum].store(alive);
+  if (alive) {
+    mAliveCount++;
+  }
+  else {
+    mAliveCount--;
+  }
+
+  if (mNodeId != COORDINATOR_NODE || mDone.load() || mAliveCount.load() > 1) {
+    return;
+  }
+
+  // If the last two players finished each other off, the last one standing wins
+  size_t winner = playerNum;
+  for (size_t i = 0; i < mNumThreads; ++i) {
+    if (mAliveView[i].load()) {
+      winner = i;
+      break;
+    }
+  }
+
+  BattleshipNetwork::message_t message = { BattleshipNetwork::MESSAGE_DONE, static_cast<uint32_t>(mNodeId),
+                                           static_cast<uint32_t>(winner), static_cast<uint32_t>(winner) };
+  mNetwork->broadcast(message);
+  finishBattle(winner);
+}
+
+
+void Battleship::finishBattle(size_t winner) {
+  if (mDone.exchange(true)) {
+    return;
+  }
+  mWinner = winner;
+  for (auto &cv : mCvs) {
+    cv.notify_all();
+  }
+  logAndPrintAlways("Player ", winner, " just won the battle.\n");
+}
+
+
+/****************************************************************
+* generateNetworkReport:
+*   Caller must hold the COUT and LOG mutexes.
+****************************************************************/
+void Battleship::generateNetworkReport() {
+  const double seconds =
+      std::chrono::duration_cast<std::chrono::duration<double>>(mBattleEndTimePoint - mBattleStartTimePoint).count();
+
+  mReport += "\nNetwork Statistics:\n";
+  mReport += "  Node " + std::to_string(mNodeId) + " of " + std::to_string(mPeers.size()) + ", players "
+             + std::to_string(mLocalBegin) + " to " + std::to_string(mLocalEnd - 1) + "\n";
+  mReport += "  Batch Size: " + std::to_string(mNetwork->getBatchSize()) + " messages\n";
+  if (!mNetwork->getError().empty()) {
+    mReport += "  Error: " + mNetwork->getError() + "\n";
+  }
+  for (size_t node = 0; node < mPeers.size(); ++node) {
+    if (node == mNodeId) {
+      continue;
+    }
+    const BattleshipNetwork::linkStats_t stats = mNetwork->getLinkStats(node);
+    const size_t capacity = stats.batchesSent * mNetwork->getBatchSize();
+    const double fill =
+        capacity == 0 ? 0.0 : static_cast<double>(stats.messagesSent) / static_cast<double>(capacity);
+    mReport += "  Link to node " + std::to_string(node) + " (" + mPeers[node] + "):\n";
+    mReport += "    Sent:     " + std::to_string(stats.bytesSent) + " bytes, " + std::to_string(stats.messagesSent)
+               + " messages, " + std::to_string(stats.batchesSent) + " batches\n";
+    mReport += "    Received: " + std::to_string(stats.bytesReceived) + " bytes, "
+               + std::to_string(stats.messagesReceived) + " messages\n";
+    if (seconds > 0) {
+      mReport += "    Rate:     " + std::to_string(static_cast<double>(stats.bytesSent) / seconds) + " bytes/s, "
+                 + std::to_string(static_cast<double>(stats.messagesSent) / seconds) + " messages/s sent\n";
+    }
+    mReport += "    Batch Fill Ratio: " + std::to_string(fill) + "\n";
+  }
+}
@@ -0,0 +1,101 @@
+/**
+* @Filename: Battleship_Engine.cpp
+* @Author:   Ben Sokol <Ben>
+* @Email:    ben@bensokol.com
+* @Created:  October 18th, 2026 [9:15pm]
+* @Modified: October 19th, 2026 [12:15am]
+* @Version:  1.0.0
+*
+* Copyright (C) 2019 by Ben Sokol. All Rights Reserved.
+*/
+
+#include <cstdlib>  // size_t
+#include <string>   // std::string
+#include <utility>  // std::move
+
+#include "BattleshipBoard.hpp"
+#include "BattleshipPlayer.hpp"
+
+#include "Battleship.hpp"
+
+
+/****************************************************************
+* Battleship (Constructor):
+*   Builds a game from aConfig instead of a command line, for
+*   embedding the engine. Distributed mode, checkpoints and the
+*   tooling options are only available from the command line.
+****************************************************************/
+Battleship::Battleship(const config_t &aConfig) : Battleship() {
+  mSilent = aConfig.silent;
+  mNumThreads = aConfig.players;
+  mSize = aConfig.size;
+  mTargets = aConfig.targets;
+  mNumWorkers = aConfig.workers;
+  mSeed = aConfig.seed;
+  mNumArenas = aConfig.arenas;
+  mAttackBatch = aConfig.attackBatch;
+  mTryLockTargeting = aConfig.tryLockTargeting;
+  mEngine = aConfig.engine;
+  mGames = aConfig.games;
+  mPages = aConfig.pages;
+  mBoards = aConfig.boards;
+  mReviveOdds = aConfig.reviveOdds;
+  mReviveBelow = aConfig.reviveBelow;
+
+  // The command line checks these while parsing
+  if (mNumThreads < 2 || mSize == 0 || mSize > BattleshipBoard::coordinate_t::MAX_LINES || mTargets == 0) {
+    invalidParameters("Failed input validation. P must be at least 2, N from 1 to 65535 and M greater than 0");
+    return;
+  }
+  if (mNumArenas == 0 || mAttackBatch == 0 || mAttackBatch > BattleshipPlayer::MAX_ATTACK_BATCH || mReviveBelow == 0
+      || mReviveBelow > 100) {
+    invalidParameters("Failed input validation. arenas must be at least 1, attackBatch from 1 to 64 and reviveBelow "
+                      "from 1 to 100");
+    return;
+  }
+  if (!validateParameters()) {
+    return;
+  }
+  initEngine();
+}
+
+
+void Battleship::addCallback(callback_t aCallback) {
+  mCallbacks.push_back(std::move(aCallback));
+}
+
+
+bool Battleship::isValid() const {
+  return mValidInputParameters;
+}
+
+
+const std::string &Battleship::getError() const {
+  return mError;
+}
+
+
+// The winner of the last run, the largest size_t until there is one
+size_t Battleship::getWinner() const {
+  return mWinner;
+}
+
+
+const std::string &Battleship::getReport() const {
+  return mReport;
+}
+
+
+/****************************************************************
+* emitEvent:
+*   Costs one branch when nothing is registered.
+****************************************************************/
+void Battleship::emitEvent(EVENT aType, size_t aPlayer, size_t aOther) {
+  if (mCallbacks.empty()) {
+    return;
+  }
+  const event_t event = { aType, aPlayer, aOther };
+  for (auto &callback : mCallbacks) {
+    callback(event);
+  }
+}
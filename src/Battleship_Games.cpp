@@ -0,0 +1,101 @@
+/**
+* @Filename: Battleship_Games.cpp
+* @Author:   Ben Sokol <Ben>
+* @Email:    ben@bensokol.com
+* @Created:  October 18th, 2026 [10:05pm]
+* @Modified: October 18th, 2026 [10:05pm]
+* @Version:  1.0.0
+*
+* Copyright (C) 2019 by Ben Sokol. All Rights Reserved.
+*/
+
+#include <algorithm>  // std::min
+#include <chrono>     // std::chrono::high_resolution_clock
+#include <cstdint>    // uint64_t
+#include <cstdlib>    // size_t
+#include <memory>     // std::unique_ptr
+#include <string>     // std::string, std::to_string
+#include <vector>     // std::vector
+
+#include "BattleshipGames.hpp"
+#include "BattleshipWorkerPool.hpp"
+
+#include "Battleship.hpp"
+
+
+/****************************************************************
+* runGames:
+*   --games. Game i is played with seed mSeed + i, and the games
+*   are split into whole vectors over a few tasks per worker, so a
+*   slow worker only holds up a small share of them.
+****************************************************************/
+void Battleship::runGames() {
+  mPool = std::unique_ptr<BattleshipWorkerPool>(new BattleshipWorkerPool(mNumWorkers));
+
+  const uint64_t lanes = BattleshipGames::getLanes(mGamesWidth);
+  const uint64_t vectors = mGames / lanes + (mGames % lanes != 0 ? 1 : 0);
+  const size_t tasks = static_cast<size_t>(std::min<uint64_t>(vectors, mNumWorkers * 8));
+  std::vector<BattleshipGames::result_t> results(tasks);
+
+  logAndPrintAlways("Playing ", mGames, " Games...\n");
+  mBattleStartTimePoint = std::chrono::high_resolution_clock::now();
+  mPool->parallelFor(tasks, 1, [this, lanes, vectors, tasks, &results](size_t task) {
+    const uint64_t share = vectors / tasks;
+    const uint64_t extra = vectors % tasks;
+    const uint64_t begin = task * share + std::min<uint64_t>(task, extra);
+    const uint64_t end = begin + share + (task < extra ? 1 : 0);
+
+    // The last vector may be partly filled, and end * lanes may not fit in a uint64_t
+    const uint64_t firstGame = begin * lanes;
+    const uint64_t lastGame = (end == vectors) ? mGames : end * lanes;
+    BattleshipGames::play(mGamesWidth, mSize, mTargets, mSeed + firstGame, lastGame - firstGame, results[task]);
+  });
+  mBattleEndTimePoint = std::chrono::high_resolution_clock::now();
+
+  mGamesResult = BattleshipGames::result_t();
+  for (const BattleshipGames::result_t &result : results) {
+    mGamesResult += result;
+  }
+  logAndPrintAlways("Completed Games.\n\n");
+
+  generateGamesReport();
+  logAndPrintAlways(mReport);
+}
+
+
+/****************************************************************
+* generateGamesReport:
+*
+****************************************************************/
+void Battleship::generateGamesReport() {
+  const BattleshipGames::result_t &result = mGamesResult;
+  const uint64_t attacks = result.attacks[0] + result.attacks[1];
+  const double seconds
+      = std::chrono::duration_cast<std::chrono::duration<double>>(mBattleEndTimePoint - mBattleStartTimePoint).count();
+  const double attacksPerSecond = seconds > 0 ? attacks / seconds : 0.0;
+
+  mReport += "Battle Details:\n";
+  mReport += "  P = " + std::to_string(mNumThreads) + "\n";
+  mReport += "  M = " + std::to_string(mTargets) + "\n";
+  mReport += "  N = " + std::to_string(mSize) + "\n";
+  mReport += "  Seed = " + std::to_string(mSeed) + "\n";
+  mReport += "  Games = " + std::to_string(mGames) + "\n";
+  mReport += std::string("  SIMD = ") + BattleshipGames::getName(mGamesWidth) + " ("
+             + std::to_string(BattleshipGames::getLanes(mGamesWidth)) + " games at a time)\n";
+  mReport += "  Workers = " + std::to_string(mNumWorkers) + "\n";
+
+  mReport += "\nGame Results:\n";
+  for (size_t player = 0; player < 2; ++player) {
+    const double rate = result.games > 0 ? 100.0 * result.wins[player] / result.games : 0.0;
+    mReport += "  Player " + std::to_string(player) + " won " + std::to_string(result.wins[player]) + " games ("
+               + std::to_string(rate) + "%), launching " + std::to_string(result.attacks[player]) + " attacks with "
+               + std::to_string(result.hits[player]) + " hits\n";
+  }
+  mReport += "  Attacks Launched: " + std::to_string(attacks) + "\n";
+  mReport += "  Attacks per Game: " + std::to_string(result.games > 0 ? double(attacks) / result.games : 0.0) + "\n";
+
+  mReport += "\nTime Statistics:\n";
+  mReport += "  Games took " + std::to_string(seconds) + " seconds.\n";
+  mReport += "  " + std::to_string(attacksPerSecond / 1e6) + " million attacks per second, "
+             + std::to_string(attacksPerSecond / 1e6 / mNumWorkers) + " per worker.\n";
+}
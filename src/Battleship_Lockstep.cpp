@@ -0,0 +1,204 @@
+/**
+* @Filename: Battleship_Lockstep.cpp
+* @Author:   Ben Sokol <Ben>
+* @Email:    ben@bensokol.com
+* @Created:  October 18th, 2026 [9:40pm]
+* @Modified: October 19th, 2026 [12:15am]
+* @Version:  1.0.0
+*
+* Copyright (C) 2019 by Ben Sokol. All Rights Reserved.
+*/
+
+#include <algorithm>  // std::fill, std::min
+#include <cstdlib>    // size_t
+#include <vector>     // std::vector
+
+#include "BattleshipTrace.hpp"
+#include "UTL_assert.h"
+
+#include "Battleship.hpp"
+
+
+/****************************************************************
+* battleLockstep:
+*   Runs on the main thread, with every phase of a round spread
+*   over the workers. Each phase only writes what belongs to one
+*   player, so no lock is ever contended and the order of the
+*   workers never matters.
+****************************************************************/
+void Battleship::battleLockstep() {
+  mIntents.assign(mNumThreads, intent_t());
+  mLockstepAlive.assign(mNumThreads, 0);
+  mAttackers.assign(mNumThreads, 0);
+  mAttackersBegin.assign(mNumThreads + 1, 0);
+  mArenaAlive.assign(mArenas.size(), 0);
+  for (size_t i = mLocalBegin; i < mLocalEnd; ++i) {
+    if (mArenaOfPlayer[i] != NO_ARENA && mPlayers[i]->isAlive()) {
+      mLockstepAlive[i] = 1;
+      mArenaAlive[mArenaOfPlayer[i]]++;
+    }
+  }
+
+  const size_t localPlayers = mLocalEnd - mLocalBegin;
+  const size_t chunk = localPlayers / (mNumWorkers * 8);
+  while (!mDone && mArenasRemaining.load() > 0) {
+    BattleshipTrace::Span span("lockstepRound");
+
+    // Every live player picks an opponent and a revive against the state at the start of the round
+    mPool->parallelFor(localPlayers, chunk, [this](size_t i) { pickLockstep(mLocalBegin + i); });
+
+    // Group the attackers by target. Filling in reverse leaves mAttackersBegin[t] at the start of t's attackers.
+    std::fill(mAttackersBegin.begin(), mAttackersBegin.end(), 0);
+    for (size_t i = mLocalBegin; i < mLocalEnd; ++i) {
+      if (mIntents[i].target != NO_PLAYER) {
+        mAttackersBegin[mIntents[i].target]++;
+      }
+    }
+    for (size_t i = 1; i <= mNumThreads; ++i) {
+      mAttackersBegin[i] += mAttackersBegin[i - 1];
+    }
+    for (size_t i = mLocalEnd; i-- > mLocalBegin;) {
+      if (mIntents[i].target != NO_PLAYER) {
+        mAttackers[--mAttackersBegin[mIntents[i].target]] = i;
+      }
+    }
+
+    // Each target takes its attacks in attacker order, then each attacker records its results
+    mPool->parallelFor(localPlayers, chunk, [this](size_t i) { applyLockstep(mLocalBegin + i); });
+    mPool->parallelFor(localPlayers, chunk, [this](size_t i) {
+      const intent_t &intent = mIntents[mLocalBegin + i];
+      if (intent.target != NO_PLAYER) {
+        mPlayers[mLocalBegin + i]->recordAttacksLaunched(intent.counts);
+        recordReviveLatency(mLocalBegin + i);
+      }
+    });
+
+    settleLockstep();
+    mLockstepRounds++;
+  }
+}
+
+
+/****************************************************************
+* pickLockstep:
+*   The choices of battleTurn, pickOpponent and reviveOpponent,
+*   made from mLockstepAlive with the player's own generator, so
+*   they do not depend on which worker runs them or when.
+****************************************************************/
+void Battleship::pickLockstep(size_t playerNum) {
+  intent_t &intent = mIntents[playerNum];
+  intent = intent_t();
+  intent.target = NO_PLAYER;
+  intent.revive = NO_PLAYER;
+  if (mArenaOfPlayer[playerNum] == NO_ARENA || !mLockstepAlive[playerNum]) {
+    return;
+  }
+  const arena_t &arena = *mArenas[mArenaOfPlayer[playerNum]];
+  if (arena.done) {
+    return;
+  }
+  const std::vector<size_t> &players = arena.players;
+  BattleshipRandom &rng = mRngs[playerNum];
+
+  size_t index = rng() % players.size();
+  for (size_t i = 0; i < players.size(); ++i) {
+    if (players[index] != playerNum && mLockstepAlive[players[index]]) {
+      intent.target = players[index];
+      break;
+    }
+    index = (index + 1) % players.size();
+  }
+  if (intent.target == NO_PLAYER) {
+    return;
+  }
+
+  const size_t targetsAlive = mArenaAlive[mArenaOfPlayer[playerNum]];
+  if (shouldRevive(targetsAlive, players.size(), rng)) {
+    size_t reviveIndex = rng() % players.size();
+    for (size_t i = 0; i < players.size(); ++i) {
+      if (players[reviveIndex] != playerNum && !mLockstepAlive[players[reviveIndex]]) {
+        intent.revive = players[reviveIndex];
+        break;
+      }
+      reviveIndex = (reviveIndex + 1) % players.size();
+    }
+  }
+}
+
+
+/****************************************************************
+* applyLockstep:
+*   Every attack on target this round, in attacker order. Once the
+*   target is sunk the remaining attackers find it dead, as they
+*   would in fireSalvo.
+****************************************************************/
+void Battleship::applyLockstep(size_t target) {
+  BattleshipPlayer &player = *mPlayers[target];
+  for (size_t i = mAttackersBegin[target]; i < mAttackersBegin[target + 1] && player.isAlive(); ++i) {
+    const size_t attacker = mAttackers[i];
+    intent_t &intent = mIntents[attacker];
+    const size_t shots = player.receiveSalvo(attacker, mAttackBatch, intent.counts);
+    intent.sunk = !player.isAlive();
+    logAndPrint("Player ", attacker, " fired ", shots, " shots at player ", target, ".\n");
+  }
+}
+
+
+/****************************************************************
+* settleLockstep:
+*   Between rounds, on the main thread. Sinkings are reported and
+*   revives applied in player order, then each arena's survivors
+*   are counted for the next round. If the last players of an
+*   arena sink each other in the same round, the lowest numbered
+*   of them is revived and wins.
+****************************************************************/
+void Battleship::settleLockstep() {
+  for (size_t i = mLocalBegin; i < mLocalEnd; ++i) {
+    if (mIntents[i].sunk) {
+      emitEvent(EVENT_PLAYER_SUNK, mIntents[i].target, i);
+    }
+  }
+
+  // A player picked by several others is revived once
+  for (size_t i = mLocalBegin; i < mLocalEnd; ++i) {
+    const size_t revive = mIntents[i].revive;
+    if (revive != NO_PLAYER && !mPlayers[revive]->isAlive()) {
+      logAndPrint("Player ", revive, " is being revived.\n");
+      revivePlayer(revive);
+      emitEvent(EVENT_PLAYER_REVIVED, revive, i);
+    }
+  }
+
+  for (size_t a = 0; a < mArenas.size(); ++a) {
+    arena_t &arena = *mArenas[a];
+    if (arena.done) {
+      continue;
+    }
+
+    size_t targetsAlive = 0;
+    size_t survivor = NO_PLAYER;
+    size_t lowest = NO_PLAYER;
+    for (size_t player : arena.players) {
+      if (mLockstepAlive[player]) {
+        lowest = std::min(lowest, player);
+      }
+      mLockstepAlive[player] = mPlayers[player]->isAlive() ? 1 : 0;
+      if (mLockstepAlive[player]) {
+        targetsAlive++;
+        survivor = player;
+      }
+    }
+
+    if (targetsAlive == 0) {
+      UTL_assert(lowest != NO_PLAYER);
+      revivePlayer(lowest);
+      mLockstepAlive[lowest] = 1;
+      targetsAlive = 1;
+      survivor = lowest;
+    }
+    mArenaAlive[a] = targetsAlive;
+    if (targetsAlive == 1 && winArena(arena, survivor)) {
+      announceArenaWinner(survivor);
+    }
+  }
+}
@@ -0,0 +1,229 @@
+/**
+* @Filename: Battleship_Memory.cpp
+* @Author:   Ben Sokol <Ben>
+* @Email:    ben@bensokol.com
+* @Created:  October 18th, 2026 [8:50pm]
+* @Modified: October 19th, 2026 [2:05am]
+* @Version:  1.0.0
+*
+* Copyright (C) 2019 by Ben Sokol. All Rights Reserved.
+*/
+
+#include <algorithm>  // std::min, std::max
+#include <cstdint>    // uint64_t
+#include <cstdio>     // BUFSIZ
+#include <cstdlib>    // size_t
+#include <iostream>   // std::cout
+#include <memory>     // std::unique_ptr
+#include <mutex>      // std::mutex
+#include <string>     // std::string, std::to_string
+#include <thread>     // std::thread::hardware_concurrency
+
+#include <sys/resource.h>
+
+#include "BattleshipAllocations.hpp"
+#include "BattleshipTrace.hpp"
+#include "UTL_colors.h"
+
+#include "Battleship.hpp"
+
+
+namespace {
+  // Stack reserved for every std::thread, glibc uses RLIMIT_STACK unless it is unlimited
+  size_t threadStackBytes() {
+    struct rlimit limit;
+    if (getrlimit(RLIMIT_STACK, &limit) == 0 && limit.rlim_cur != RLIM_INFINITY) {
+      return static_cast<size_t>(limit.rlim_cur);
+    }
+    return size_t(2) << 20;
+  }
+
+  std::string formatBytes(size_t aBytes) {
+    if (aBytes >= (size_t(10) << 20)) {
+      return std::to_string(aBytes >> 20) + " MiB";
+    }
+    else if (aBytes >= (size_t(10) << 10)) {
+      return std::to_string(aBytes >> 10) + " KiB";
+    }
+    return std::to_string(aBytes) + " bytes";
+  }
+}  // namespace
+
+
+/****************************************************************
+* workerCount:
+*   Bounded number of workers, each one takes turns for many
+*   players. --games shares out games rather than players.
+****************************************************************/
+size_t Battleship::workerCount(size_t localPlayers) const {
+  const size_t workers = mNumWorkers > 0 ? mNumWorkers : std::max<size_t>(1, std::thread::hardware_concurrency());
+  if (mGames > 0) {
+    return workers;
+  }
+  if (mEngine == ENGINE_SEQUENTIAL) {
+    return 1;
+  }
+  return std::min(workers, localPlayers);
+}
+
+
+/****************************************************************
+* accountMemory:
+*   Bytes held by each subsystem. With aEstimate nothing has been
+*   allocated yet, so the same figures are predicted from P, N, M
+*   and the options.
+****************************************************************/
+Battleship::memoryUsage_t Battleship::accountMemory(bool aEstimate) {
+  memoryUsage_t usage = {};
+  const size_t nodes = std::max<size_t>(1, mPeers.size());
+  const size_t localPlayers = aEstimate ? (mNumThreads + nodes - 1) / nodes : mLocalEnd - mLocalBegin;
+
+  // Board cells
+  if (aEstimate) {
+    const BattleshipBoard::footprint_t footprint = BattleshipBoard::estimateFootprint(mSize, mBoards);
+    usage.initialCells = footprint.initialCells * localPlayers;
+    usage.currentCells = footprint.currentCells * localPlayers;
+    usage.boardOverhead = footprint.overhead * localPlayers;
+  }
+  else {
+    for (size_t i = mLocalBegin; i < mLocalEnd; ++i) {
+      const BattleshipBoard::footprint_t footprint = mPlayers[i]->getBoardFootprint();
+      usage.initialCells += footprint.initialCells;
+      usage.currentCells += footprint.currentCells;
+      usage.boardOverhead += footprint.overhead;
+    }
+  }
+
+  // The player itself, plus its slot in every per-player vector
+  usage.playerBytes = sizeof(BattleshipPlayer) + sizeof(std::unique_ptr<BattleshipPlayer>) + sizeof(std::mutex)
+                      + sizeof(BattleshipRandom) + sizeof(size_t) * 2;
+  usage.playerOverhead = usage.playerBytes * localPlayers + (mNumThreads - localPlayers) * sizeof(std::mutex);
+
+  // Workers, plus the checkpoint, monitor and network threads
+  usage.threads = aEstimate ? workerCount(localPlayers) : mNumWorkers;
+  usage.threads += (mCheckpointFile.empty() ? 0 : 1) + (mMonitorInterval > 0 ? 1 : 0) + (mPeers.empty() ? 0 : 1);
+  usage.threadStacks = usage.threads * threadStackBytes();
+
+  usage.logBuffer = (aEstimate || mLogFile.is_open()) ? BUFSIZ : 0;
+#ifndef ENABLE_LOGGING
+  usage.logBuffer = 0;
+#endif
+  usage.traceBuffers = aEstimate ? 0 : BattleshipTrace::getBufferBytes();
+  usage.report = aEstimate ? BattleshipPlayer::REPORT_BYTES * localPlayers : mReport.capacity();
+  return usage;
+}
+
+
+/****************************************************************
+* sampleResources:
+*   Peak RSS and page faults so far, Linux reports ru_maxrss in KiB
+*   and macOS in bytes.
+****************************************************************/
+void Battleship::sampleResources(resources_t &resources) {
+  struct rusage usage;
+  resources = resources_t();
+  if (getrusage(RUSAGE_SELF, &usage) == 0) {
+#ifdef __APPLE__
+    resources.peakRssBytes = static_cast<size_t>(usage.ru_maxrss);
+#else
+    resources.peakRssBytes = static_cast<size_t>(usage.ru_maxrss) * 1024;
+#endif
+    resources.minorFaults = static_cast<size_t>(usage.ru_minflt);
+    resources.majorFaults = static_cast<size_t>(usage.ru_majflt);
+  }
+  resources.allocations = BattleshipAllocations::getTotals();
+}
+
+
+/****************************************************************
+* generateMemoryReport:
+*   Caller must hold the COUT and LOG mutexes.
+****************************************************************/
+void Battleship::generateMemoryReport() {
+  const memoryUsage_t usage = accountMemory(false);
+  const size_t total = usage.initialCells + usage.currentCells + usage.boardOverhead + usage.playerOverhead
+                       + usage.logBuffer + usage.traceBuffers + usage.report;
+
+  mReport += "\nMemory:\n";
+  mReport += "  Board Cells (Initial): " + formatBytes(usage.initialCells) + "\n";
+  mReport += "  Board Cells (Current): " + formatBytes(usage.currentCells) + "\n";
+  mReport += "  Board Overhead:        " + formatBytes(usage.boardOverhead) + "\n";
+  mReport += "  Player Overhead:       " + formatBytes(usage.playerOverhead) + " ("
+             + std::to_string(usage.playerBytes) + " bytes per player)\n";
+  mReport += "  Log Buffer:            " + formatBytes(usage.logBuffer) + "\n";
+  mReport += "  Trace Buffers:         " + formatBytes(usage.traceBuffers) + "\n";
+  mReport += "  Report:                " + formatBytes(usage.report) + "\n";
+  mReport += "  Total:                 " + formatBytes(total) + "\n";
+  mReport += "  Thread Stacks:         " + formatBytes(usage.threadStacks) + " reserved for "
+             + std::to_string(usage.threads) + " threads\n";
+
+  mReport += "  Initial Phase: " + describeResources(mStartResources, mInitResources) + "\n";
+  mReport += "  Battle Phase:  " + describeResources(mInitResources, mBattleResources) + "\n";
+
+  // Built with ENABLE_ALLOCATION_TRACKING
+  if (BattleshipAllocations::isEnabled()) {
+    uint64_t attacks = 0;
+    for (size_t i = mLocalBegin; i < mLocalEnd; ++i) {
+      const BattleshipPlayer::stats_t stats = mPlayers[i]->snapshot();
+      attacks += stats.attacksLaunchedInitialHits + stats.attacksLaunchedInitialMisses
+                 + stats.attacksLaunchedSecondaryHits + stats.attacksLaunchedSecondaryMisses;
+    }
+    const uint64_t allocations = mBattleResources.allocations.allocations - mInitResources.allocations.allocations;
+    const uint64_t forbidden = mBattleResources.allocations.forbidden - mInitResources.allocations.forbidden;
+    const uint64_t allowed = mBattleResources.allocations.allowed - mInitResources.allocations.allowed;
+    const uint64_t allowedBytes
+        = mBattleResources.allocations.allowedBytes - mInitResources.allocations.allowedBytes;
+    mReport += "  Battle Allocations: " + std::to_string(attacks > 0 ? double(allocations) / attacks : 0.0)
+               + " per attack, " + std::to_string(forbidden) + " forbidden and " + std::to_string(allowed)
+               + " allowed of " + formatBytes(allowedBytes) + " in battle turns\n";
+    if (mBoards == BattleshipBoard::STORAGE_LAZY) {
+      mReport += "  Lazy board tables grow with the attacks, so lazy boards are exempt and are counted as allowed\n";
+    }
+  }
+}
+
+
+/****************************************************************
+* describeResources:
+*   Peak RSS at the end of a phase and the page faults during it,
+*   plus the heap allocations during it if they are tracked.
+****************************************************************/
+std::string Battleship::describeResources(const resources_t &aBefore, const resources_t &aAfter) const {
+  std::string str = "peak RSS " + formatBytes(aAfter.peakRssBytes) + ", "
+                    + std::to_string(aAfter.minorFaults - aBefore.minorFaults) + " minor and "
+                    + std::to_string(aAfter.majorFaults - aBefore.majorFaults) + " major page faults";
+  if (BattleshipAllocations::isEnabled()) {
+    str += ", " + std::to_string(aAfter.allocations.allocations - aBefore.allocations.allocations) + " allocations of "
+           + formatBytes(aAfter.allocations.bytes - aBefore.allocations.bytes) + " and "
+           + std::to_string(aAfter.allocations.frees - aBefore.allocations.frees) + " frees";
+  }
+  return str;
+}
+
+
+/****************************************************************
+* printEstimate:
+*   --estimate, nothing is allocated for the players.
+****************************************************************/
+void Battleship::printEstimate() {
+  const memoryUsage_t usage = accountMemory(true);
+  const size_t total = usage.initialCells + usage.currentCells + usage.boardOverhead + usage.playerOverhead
+                       + usage.logBuffer + usage.report;
+
+  std::cout << "Memory Estimate (P = " << mNumThreads << ", N = " << mSize << ", M = " << mTargets;
+  if (!mPeers.empty()) {
+    std::cout << ", per node of " << mPeers.size();
+  }
+  std::cout << "):\n";
+  std::cout << "  Board Cells (Initial): " << formatBytes(usage.initialCells) << "\n";
+  std::cout << "  Board Cells (Current): " << formatBytes(usage.currentCells) << "\n";
+  std::cout << "  Board Overhead:        " << formatBytes(usage.boardOverhead) << "\n";
+  std::cout << "  Player Overhead:       " << formatBytes(usage.playerOverhead) << " (" << usage.playerBytes
+            << " bytes per player)\n";
+  std::cout << "  Log Buffer:            " << formatBytes(usage.logBuffer) << "\n";
+  std::cout << "  Report:                " << formatBytes(usage.report) << "\n";
+  std::cout << "  Thread Stacks:         " << formatBytes(usage.threadStacks) << " reserved for " << usage.threads
+            << " threads\n";
+  std::cout << "  Total:                 " << formatBytes(total) << "\n";
+  std::cout << "Estimated Bytes = " << total << "\n";
+}
@@ -3,7 +3,7 @@
 * @Author:   Ben Sokol <Ben>
 * @Email:    ben@bensokol.com
 * @Created:  February 15th, 2019 [1:19pm]
-* @Modified: February 21st, 2019 [12:54pm]
+* @Modified: October 19th, 2026 [12:15am]
 * @Version:  1.0.0
 *
 * Copyright (C) 2019 by Ben Sokol. All Rights Reserved.
@@ -40,8 +40,13 @@ void Battleship::printHelp() {
   std::cout << "\n" << COLOR_RED_BOLD << "SYNOPSIS" << COLOR_RESET;
   std::cout << "\n\t" << COLOR_RED_BOLD << "battleship --help" << COLOR_RESET;
   std::cout << "\n\t" << COLOR_RED_BOLD << "battleship --version" << COLOR_RESET;
+  std::cout << "\n\t" << COLOR_RED_BOLD << "battleship --resume" << COLOR_RESET << " " << COLOR_GREEN_BOLD << "FILE"
+            << COLOR_RESET << " [" << COLOR_GREEN_BOLD << "OPTIONS" << COLOR_RESET << "]";
   std::cout << "\n\t" << COLOR_RED_BOLD << "battleship" << COLOR_RESET << " " << COLOR_GREEN_BOLD << "P N M"
-            << COLOR_RESET;
+            << COLOR_RESET << " [" << COLOR_GREEN_BOLD << "OPTIONS" << COLOR_RESET << "]";
+  std::cout << "\n\t" << COLOR_RED_BOLD << "battleship --sweep=" << COLOR_RESET << COLOR_GREEN_BOLD << "FILE"
+            << COLOR_RESET << " [" << COLOR_GREEN_BOLD << "--cores=COUNT" << COLOR_RESET << "] ["
+            << COLOR_GREEN_BOLD << "--format=csv|json" << COLOR_RESET << "]";
 
   // Description
   std::cout << "\n";
@@ -56,10 +61,72 @@ void Battleship::printHelp() {
   std::cout << "\n";
   std::cout << "\n" << COLOR_RED_BOLD << "INPUT PAREMETERS" << COLOR_RESET;
   std::cout << "\n";
-  std::cout << "\n\t" << COLOR_GREEN_BOLD << "P" << COLOR_RESET << "\tNumber of threads to spawn. (P≥2)";
-  std::cout << "\n\t" << COLOR_GREEN_BOLD << "N" << COLOR_RESET << "\tThe size of the board NxN (N>0)";
+  std::cout << "\n\t" << COLOR_GREEN_BOLD << "P" << COLOR_RESET << "\tNumber of players. (P≥2)";
+  std::cout << "\n\t" << COLOR_GREEN_BOLD << "N" << COLOR_RESET << "\tThe size of the board NxN (0<N≤65535)";
   std::cout << "\n\t" << COLOR_GREEN_BOLD << "M" << COLOR_RESET << "\tThe number of randomly placed targets (M>0)";
 
+  // Options
+  std::cout << "\n";
+  std::cout << "\n" << COLOR_RED_BOLD << "OPTIONS" << COLOR_RESET;
+  std::cout << "\n";
+  std::cout << "\n\t" << COLOR_GREEN_BOLD << "--workers=COUNT" << COLOR_RESET
+            << "\n\t\tThreads that take turns for the players (default one per core, at most P).";
+  std::cout << "\n\t" << COLOR_GREEN_BOLD << "--arenas=K" << COLOR_RESET
+            << "\n\t\tTournament mode. Split the players into K arenas (K≤P/2), arena winners advance.";
+  std::cout << "\n\t" << COLOR_GREEN_BOLD << "--attack-batch=K" << COLOR_RESET
+            << "\n\t\tFire salvos of K shots (K≤64), chosen before any of them land (default 1).";
+  std::cout << "\n\t" << COLOR_GREEN_BOLD << "--targeting=lock|trylock" << COLOR_RESET
+            << "\n\t\tWith trylock, a locked opponent is skipped for another instead of waited on (default lock).";
+  std::cout << "\n\t" << COLOR_GREEN_BOLD << "--revive-odds=K" << COLOR_RESET
+            << "\n\t\tA turn revives a dead player one time in K, 0 never revives (default 10).";
+  std::cout << "\n\t" << COLOR_GREEN_BOLD << "--revive-below=PERCENT" << COLOR_RESET
+            << "\n\t\tOnly revive while fewer than PERCENT of the arena is alive, and at least 3 (default 50).";
+  std::cout << "\n\t" << COLOR_GREEN_BOLD << "--engine=threaded|sequential|lockstep" << COLOR_RESET
+            << "\n\t\tsequential plays the same game as an event loop on one thread, with no locks. lockstep plays"
+            << "\n\t\tin synchronous rounds, the same battle for a seed on any number of workers (default threaded).";
+  std::cout << "\n\t" << COLOR_GREEN_BOLD << "--games=K" << COLOR_RESET
+            << "\n\t\tPlay K games of 2 players, seeded SEED to SEED+K-1, many at once in vector lanes (P=2, N≤8).";
+  std::cout << "\n\t" << COLOR_GREEN_BOLD << "--simd=auto|scalar|avx2|avx512" << COLOR_RESET
+            << "\n\t\tVector width for --games (default auto, the widest the CPU supports).";
+  std::cout << "\n\t" << COLOR_GREEN_BOLD << "--sweep=FILE" << COLOR_RESET
+            << "\n\t\tPlay every game of the scenario file FILE in one process, one result row per game.";
+  std::cout << "\n\t" << COLOR_GREEN_BOLD << "--cores=COUNT" << COLOR_RESET
+            << "\n\t\tWorkers shared by the games of --sweep, played at once (default one per core).";
+  std::cout << "\n\t" << COLOR_GREEN_BOLD << "--format=csv|json" << COLOR_RESET
+            << "\n\t\tRows of --sweep as CSV with a header, or one JSON object per line (default csv).";
+  std::cout << "\n\t" << COLOR_GREEN_BOLD << "--huge-pages=off|thp|explicit" << COLOR_RESET
+            << "\n\t\tAllocate players and boards on transparent or MAP_HUGETLB huge pages (default off, Linux).";
+  std::cout << "\n\t" << COLOR_GREEN_BOLD << "--boards=eager|lazy" << COLOR_RESET
+            << "\n\t\tlazy boards place no targets up front and only store the cells that are touched (default eager).";
+  std::cout << "\n\t" << COLOR_GREEN_BOLD << "--monitor=MS" << COLOR_RESET
+            << "\n\t\tPrint a snapshot of the players' stats every MS milliseconds during the battle.";
+  std::cout << "\n\t" << COLOR_GREEN_BOLD << "--view=P1,P2,..." << COLOR_RESET
+            << "\n\t\tDraw the listed players' boards live in the terminal during the battle.";
+  std::cout << "\n\t" << COLOR_GREEN_BOLD << "--view-fps=FPS" << COLOR_RESET
+            << "\n\t\tRedraw the view at most FPS times a second (default 30, at most 1000).";
+  std::cout << "\n\t" << COLOR_GREEN_BOLD << "--estimate" << COLOR_RESET
+            << "\n\t\tPrint the memory P, N and M would need, without running the simulation.";
+  std::cout << "\n\t" << COLOR_GREEN_BOLD << "--counters" << COLOR_RESET
+            << "\n\t\tReport hardware counters per phase and per worker (Linux perf_event_open).";
+  std::cout << "\n\t" << COLOR_GREEN_BOLD << "--trace=FILE" << COLOR_RESET
+            << "\n\t\tWrite a Chrome trace (chrome://tracing, ui.perfetto.dev) of every worker to FILE.";
+  std::cout << "\n\t" << COLOR_GREEN_BOLD << "--trace-sample=COUNT" << COLOR_RESET
+            << "\n\t\tOnly trace one turn in every COUNT per worker (default 1).";
+  std::cout << "\n\t" << COLOR_GREEN_BOLD << "--seed=SEED" << COLOR_RESET
+            << "\n\t\tSeed for target placement and opponent choice (default random).";
+  std::cout << "\n\t" << COLOR_GREEN_BOLD << "--checkpoint=FILE" << COLOR_RESET
+            << "\n\t\tPeriodically write the full simulation state to FILE.";
+  std::cout << "\n\t" << COLOR_GREEN_BOLD << "--checkpoint-interval=SECONDS" << COLOR_RESET
+            << "\n\t\tSeconds between checkpoints (default 10).";
+  std::cout << "\n\t" << COLOR_GREEN_BOLD << "--resume=FILE" << COLOR_RESET
+            << "\n\t\tContinue the battle saved in FILE. P, N and M are read from FILE.";
+  std::cout << "\n\t" << COLOR_GREEN_BOLD << "--peers=HOST:PORT,..." << COLOR_RESET
+            << "\n\t\tRun distributed. Lists every node, each node owns an equal shard of the P players.";
+  std::cout << "\n\t" << COLOR_GREEN_BOLD << "--node=ID" << COLOR_RESET
+            << "\n\t\tIndex of this node in --peers (default 0). Node 0 announces the winner.";
+  std::cout << "\n\t" << COLOR_GREEN_BOLD << "--net-batch=COUNT" << COLOR_RESET
+            << "\n\t\tMessages batched per frame to each node (default 64).";
+
   // Notes
   std::cout << "\n";
   std::cout << "\n" << COLOR_RED_BOLD << "NOTES" << COLOR_RESET;
@@ -74,6 +141,11 @@ void Battleship::printHelp() {
   std::cout << "\n";
   std::cout << textWrap(
       "\n\tWill run a simulation using 4 threads of 3x3 boards that each have 4 randomly placed targets.", true);
+  std::cout << "\n";
+  std::cout << "\n\t./battleship 12 10 20 --node=0 --peers=127.0.0.1:5000,127.0.0.1:5001";
+  std::cout << "\n\t./battleship 12 10 20 --node=1 --peers=127.0.0.1:5000,127.0.0.1:5001";
+  std::cout << "\n";
+  std::cout << textWrap("\n\tWill run the same 12 player simulation split across two processes on this machine.", true);
 
   // Copyright
   std::cout << "\n";
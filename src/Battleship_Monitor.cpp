@@ -0,0 +1,72 @@
+/**
+* @Filename: Battleship_Monitor.cpp
+* @Author:   Ben Sokol <Ben>
+* @Email:    ben@bensokol.com
+* @Created:  October 18th, 2026 [7:30pm]
+* @Modified: October 18th, 2026 [9:15pm]
+* @Version:  1.0.0
+*
+* Copyright (C) 2019 by Ben Sokol. All Rights Reserved.
+*/
+
+#include <chrono>   // std::chrono
+#include <cstdint>  // uint64_t
+#include <cstdlib>  // size_t
+#include <mutex>    // std::unique_lock
+#include <string>   // std::to_string
+
+#include "TS_logAndPrint.hpp"
+
+#include "Battleship.hpp"
+
+
+/****************************************************************
+* monitorLoop:
+*   Every snapshot reads each local player's published stats once,
+*   without locking the player, so the battle never waits on it.
+****************************************************************/
+void Battleship::monitorLoop() {
+  const auto startTimePoint = std::chrono::high_resolution_clock::now();
+
+  std::unique_lock<std::mutex> lck(mMonitorMtx);
+  while (!mMonitorDone) {
+    mMonitorCv.wait_for(lck, std::chrono::milliseconds(mMonitorInterval), [this]() { return mMonitorDone; });
+    if (mMonitorDone) {
+      break;
+    }
+
+    const auto snapshotTimePoint = std::chrono::high_resolution_clock::now();
+    size_t alive = 0;
+    uint64_t remainingTargets = 0;
+    uint64_t timesRevived = 0;
+    uint64_t attacksReceived = 0;
+    for (size_t i = mLocalBegin; i < mLocalEnd; ++i) {
+      const BattleshipPlayer::stats_t stats = mPlayers[i]->snapshot();
+      alive += stats.isAlive;
+      remainingTargets += stats.remainingTargets;
+      timesRevived += stats.timesRevived;
+      attacksReceived += stats.attacksReceived;
+    }
+    const auto endTimePoint = std::chrono::high_resolution_clock::now();
+
+    mMonitorSnapshots++;
+    mMonitorNanoseconds += static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(endTimePoint - snapshotTimePoint).count());
+    const std::chrono::duration<double> elapsed = snapshotTimePoint - startTimePoint;
+    logAndPrintAlways("Monitor ", elapsed.count(), "s: ", alive, "/", mLocalEnd - mLocalBegin, " alive, ",
+                      attacksReceived, " attacks, ", timesRevived, " revives, ", remainingTargets,
+                      " targets remaining\n");
+  }
+}
+
+
+/****************************************************************
+* generateMonitorReport:
+*   Caller must hold the COUT and LOG mutexes.
+****************************************************************/
+void Battleship::generateMonitorReport() {
+  mReport += "\nMonitor:\n";
+  mReport += "  Snapshots: " + std::to_string(mMonitorSnapshots) + "\n";
+  mReport += "  Average Snapshot: " + std::to_string(mMonitorNanoseconds / mMonitorSnapshots / 1000.0) + " µs for "
+             + std::to_string(mLocalEnd - mLocalBegin) + " players\n";
+}
@@ -0,0 +1,136 @@
+/**
+* @Filename: Battleship_Revive.cpp
+* @Author:   Ben Sokol <Ben>
+* @Email:    ben@bensokol.com
+* @Created:  October 18th, 2026 [11:20pm]
+* @Modified: October 19th, 2026 [12:15am]
+* @Version:  1.0.0
+*
+* Copyright (C) 2019 by Ben Sokol. All Rights Reserved.
+*/
+
+#include <chrono>   // std::chrono
+#include <cstdint>  // uint64_t
+#include <cstdlib>  // size_t
+#include <mutex>    // std::lock_guard
+#include <string>   // std::to_string
+
+#include "BattleshipAllocations.hpp"
+#include "BattleshipTrace.hpp"
+
+#include "Battleship.hpp"
+
+
+/****************************************************************
+* revivePlayer:
+*   Every engine revives through here, so each revive is counted
+*   and stamped for the latency to the player's next attack.
+****************************************************************/
+void Battleship::revivePlayer(size_t playerNum) {
+  mPlayers[playerNum]->revive();
+  const uint64_t at = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                                std::chrono::high_resolution_clock::now() - mBattleStartTimePoint)
+                                                .count());
+  mRevivedAt[playerNum].store(at + 1, std::memory_order_relaxed);
+  mRevives.fetch_add(1, std::memory_order_relaxed);
+}
+
+
+/****************************************************************
+* handOffRevived:
+*   Queues playerNum on its worker and wakes it, so the worker
+*   runs it next, whether it was parked or busy with its other
+*   players.
+****************************************************************/
+void Battleship::handOffRevived(size_t playerNum) {
+  const size_t worker = workerOfPlayer(playerNum);
+  {
+    // Reserved for every player of the worker, a player revived twice before its worker drains the list may grow it
+    BattleshipAllocations::Allow allow;
+    std::lock_guard<std::mutex> lck(mWorkerMtx[worker]);
+    mRevived[worker].players.push_back(playerNum);
+    mRevived[worker].pending.store(true);
+  }
+  mCvs[worker].notify_all();
+}
+
+
+/****************************************************************
+* battleRevived:
+*   Takes a turn for every player handed to worker since its last
+*   pass. The lists are swapped rather than copied, so once both
+*   have grown no revive allocates. Returns true if any attacked.
+****************************************************************/
+bool Battleship::battleRevived(size_t worker) {
+  revived_t &revived = mRevived[worker];
+  if (!revived.pending.load(std::memory_order_acquire)) {
+    return false;
+  }
+  {
+    std::lock_guard<std::mutex> lck(mWorkerMtx[worker]);
+    revived.taken.swap(revived.players);
+    revived.pending.store(false, std::memory_order_relaxed);
+  }
+
+  bool attacked = false;
+  for (size_t playerNum : revived.taken) {
+    BattleshipTrace::Span span("revivedTurn");
+    if (mNetwork ? battleDistributedTurn(playerNum) : battleTurn(playerNum)) {
+      attacked = true;
+    }
+  }
+  revived.taken.clear();
+  return attacked;
+}
+
+
+/****************************************************************
+* shouldRevive:
+*   One turn in mReviveOdds, while at least 3 players are alive
+*   but fewer than mReviveBelow percent of playerCount. rng is only
+*   drawn once the count allows a revive.
+****************************************************************/
+bool Battleship::shouldRevive(size_t aliveCount, size_t playerCount, BattleshipRandom &rng) const {
+  return mReviveOdds > 0 && aliveCount > 2 && aliveCount < playerCount * mReviveBelow / 100
+         && rng() % mReviveOdds == 0;
+}
+
+
+void Battleship::settleReviveLatency(size_t playerNum) {
+  const uint64_t at = mRevivedAt[playerNum].exchange(0, std::memory_order_relaxed);
+  if (at == 0) {
+    return;
+  }
+  const uint64_t now = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                                 std::chrono::high_resolution_clock::now() - mBattleStartTimePoint)
+                                                 .count());
+  const uint64_t latency = now + 1 - at;
+  mReviveLatencies.fetch_add(1, std::memory_order_relaxed);
+  mReviveLatencyNanoseconds.fetch_add(latency, std::memory_order_relaxed);
+  uint64_t max = mReviveLatencyMax.load(std::memory_order_relaxed);
+  while (latency > max && !mReviveLatencyMax.compare_exchange_weak(max, latency, std::memory_order_relaxed)) {
+  }
+}
+
+
+/****************************************************************
+* generateReviveReport:
+*   Caller must hold the COUT and LOG mutexes. Latency is only
+*   known for revived players that attacked again.
+****************************************************************/
+void Battleship::generateReviveReport() {
+  const double seconds
+      = std::chrono::duration_cast<std::chrono::duration<double>>(mBattleEndTimePoint - mBattleStartTimePoint).count();
+  const uint64_t revives = mRevives.load();
+  const uint64_t latencies = mReviveLatencies.load();
+
+  mReport += "\nRevives:\n";
+  mReport += "  Revives: " + std::to_string(revives) + " ("
+             + std::to_string(seconds > 0 ? revives / seconds : 0.0) + " per second)\n";
+  if (latencies > 0) {
+    mReport += "  Revive to First Attack: average "
+               + std::to_string(mReviveLatencyNanoseconds.load() / latencies / 1000.0) + " µs, max "
+               + std::to_string(mReviveLatencyMax.load() / 1000.0) + " µs over " + std::to_string(latencies)
+               + " revived players\n";
+  }
+}
@@ -0,0 +1,71 @@
+/**
+* @Filename: Battleship_Sequential.cpp
+* @Author:   Ben Sokol <Ben>
+* @Email:    ben@bensokol.com
+* @Created:  October 18th, 2026 [8:00pm]
+* @Modified: October 18th, 2026 [11:20pm]
+* @Version:  1.0.0
+*
+* Copyright (C) 2019 by Ben Sokol. All Rights Reserved.
+*/
+
+#include <cstdlib>  // size_t
+#include <deque>    // std::deque
+#include <memory>   // std::unique_ptr
+#include <vector>   // std::vector
+
+#include "BattleshipTrace.hpp"
+#include "TS_logAndPrint.hpp"
+
+#include "Battleship.hpp"
+
+
+/****************************************************************
+* battleSequential:
+*   The rules of battleTurn as an event loop on one thread. Every
+*   event is a turn of a live player, who is queued again after the
+*   turn. A revived player is queued when it is revived. Nothing
+*   else runs during the battle, so no arena, player or worker lock
+*   is taken and nothing ever waits.
+****************************************************************/
+void Battleship::battleSequential() {
+  std::deque<size_t> turns;
+  std::vector<bool> queued(mNumThreads, false);
+  for (auto &arena : mArenas) {
+    for (size_t playerNum : arena->players) {
+      turns.push_back(playerNum);
+      queued[playerNum] = true;
+    }
+  }
+
+  while (!turns.empty() && !mDone) {
+    const size_t playerNum = turns.front();
+    turns.pop_front();
+    queued[playerNum] = false;
+
+    arena_t &arena = *mArenas[mArenaOfPlayer[playerNum]];
+    if (arena.done || !mPlayers[playerNum]->isAlive()) {
+      continue;
+    }
+
+    BattleshipTrace::Span span("battleTurn");
+    const size_t target = pickOpponent(arena, playerNum, nullptr);
+    if (target == NO_PLAYER) {
+      if (winArena(arena, playerNum)) {
+        announceArenaWinner(playerNum);
+      }
+      continue;
+    }
+
+    const size_t revived = reviveOpponent(arena, playerNum);
+    if (revived != NO_PLAYER && !queued[revived]) {
+      turns.push_back(revived);
+      queued[revived] = true;
+    }
+
+    recordReviveLatency(playerNum);
+    attackOpponent(playerNum, target);
+    turns.push_back(playerNum);
+    queued[playerNum] = true;
+  }
+}
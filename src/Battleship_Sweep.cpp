@@ -0,0 +1,264 @@
+/**
+* @Filename: Battleship_Sweep.cpp
+* @Author:   Ben Sokol <Ben>
+* @Email:    ben@bensokol.com
+* @Created:  October 19th, 2026 [12:15am]
+* @Modified: October 19th, 2026 [12:15am]
+* @Version:  1.0.0
+*
+* Copyright (C) 2019 by Ben Sokol. All Rights Reserved.
+*/
+
+#include <algorithm>           // std::min, std::max, std::find, std::find_if
+#include <chrono>              // std::chrono
+#include <condition_variable>  // std::condition_variable
+#include <cstdlib>             // size_t
+#include <iostream>            // std::cout
+#include <memory>              // std::unique_ptr
+#include <mutex>               // std::mutex, std::unique_lock, std::lock_guard
+#include <string>              // std::string, std::to_string
+#include <thread>              // std::thread
+#include <vector>              // std::vector
+
+#include "BattleshipSweep.hpp"
+#include "BattleshipWorkerPool.hpp"
+#include "UTL_assert.h"
+#include "UTL_inputValidation.hpp"
+
+#include "Battleship.hpp"
+
+
+namespace {
+  // Scenario keys besides players, size, targets and repeat, each read as the --key=value option of the same name
+  const char *const SWEEP_OPTIONS[] = { "workers", "arenas",      "attack-batch", "targeting", "engine",
+                                        "boards",  "revive-odds", "revive-below", "seed" };
+
+  // One per value of describeSweepRun
+  const char *const COLUMNS[] = { "scenario",     "run",          "repeat",        "players",      "size",
+                                  "targets",      "engine",       "boards",        "arenas",       "attack_batch",
+                                  "targeting",    "revive_odds",  "revive_below",  "workers",      "seed",
+                                  "winner",       "attacks",      "revives",       "rounds",       "init_seconds",
+                                  "battle_seconds", "total_seconds" };
+
+  double seconds(std::chrono::high_resolution_clock::time_point aStart,
+                 std::chrono::high_resolution_clock::time_point aEnd) {
+    return std::chrono::duration_cast<std::chrono::duration<double>>(aEnd - aStart).count();
+  }
+}  // namespace
+
+
+/****************************************************************
+* loadSweep:
+*   Every point of the scenario file is checked before the first
+*   game is played, so a typo fails the sweep up front rather than
+*   hours into it.
+****************************************************************/
+bool Battleship::loadSweep() {
+  std::string error;
+  mSweep = BattleshipSweep::load(mSweepFile, error);
+  if (!mSweep) {
+    return invalidParameters(error);
+  }
+  for (const BattleshipSweep::point_t &point : mSweep->getPoints()) {
+    Battleship game;
+    if (!game.initSweepGame(point, 0)) {
+      const std::string name = mSweep->getScenarioName(point.scenario);
+      mSweep.reset();
+      return invalidParameters("Scenario " + name + ": " + game.mError);
+    }
+  }
+  if (mSweepCores == 0) {
+    mSweepCores = std::max<size_t>(1, std::thread::hardware_concurrency());
+  }
+  return true;
+}
+
+
+/****************************************************************
+* initSweepGame:
+*   Takes the parameters of a game from aPoint, with the same
+*   checks as the command line. A game gets one worker unless the
+*   scenario gives more, since a sweep is fastest with many games
+*   at once. Repeats are played with consecutive seeds.
+****************************************************************/
+bool Battleship::initSweepGame(const BattleshipSweep::point_t &aPoint, size_t aRepeat) {
+  mSilent = true;
+  mNumWorkers = 1;
+  for (const auto &value : aPoint.values) {
+    const std::string &key = value.first;
+    if (key.compare("players") == 0 && UTL::isNumber(value.second, 2)) {
+      mNumThreads = std::stoull(value.second);
+    }
+    else if (key.compare("size") == 0 && UTL::isNumber(value.second, 0)
+             && std::stoull(value.second) <= BattleshipBoard::coordinate_t::MAX_LINES) {
+      mSize = std::stoull(value.second);
+    }
+    else if (key.compare("targets") == 0 && UTL::isNumber(value.second, 0)) {
+      mTargets = std::stoull(value.second);
+    }
+    else if (std::find_if(std::begin(SWEEP_OPTIONS), std::end(SWEEP_OPTIONS),
+                          [&key](const char *option) { return key.compare(option) == 0; })
+             == std::end(SWEEP_OPTIONS)) {
+      return invalidParameters("Invalid " + key + " = " + value.second);
+    }
+    else if (!initOption("--" + key + "=" + value.second)) {
+      return false;
+    }
+  }
+  if (mNumThreads < 2 || mSize == 0 || mTargets == 0) {
+    return invalidParameters("players (at least 2), size (1 to 65535) and targets (at least 1) are required");
+  }
+  if (!validateParameters()) {
+    return false;
+  }
+  mSeed += aRepeat;
+  return true;
+}
+
+
+/****************************************************************
+* runSweep:
+*   A runner per core builds the next game, waits until its
+*   workers fit in the core budget and its turn has come, so games
+*   start in file order, and plays it. Idle worker pools are handed
+*   to the next game that needs the same number of workers. Pools
+*   of other sizes are stopped before a new one is started, so
+*   there are never more workers than cores. Freed boards and
+*   players are reused by the allocator for the next game, rather
+*   than by a new process.
+****************************************************************/
+void Battleship::runSweep() {
+  const std::vector<BattleshipSweep::run_t> &runs = mSweep->getRuns();
+  std::mutex mtx;
+  std::condition_variable cv;
+  size_t nextBuild = 0;
+  size_t nextStart = 0;
+  size_t freeCores = mSweepCores;
+  std::vector<std::unique_ptr<BattleshipWorkerPool>> idlePools;
+
+  if (!mSweepJson) {
+    std::string header;
+    for (const char *column : COLUMNS) {
+      header += std::string(header.empty() ? "" : ",") + column;
+    }
+    std::cout << header << "\n" << std::flush;
+  }
+
+  auto runner = [&]() {
+    while (true) {
+      size_t run;
+      {
+        std::lock_guard<std::mutex> lck(mtx);
+        if (nextBuild == runs.size()) {
+          return;
+        }
+        run = nextBuild++;
+      }
+
+      // Checked by loadSweep, so only the seed can differ
+      std::unique_ptr<Battleship> game(new Battleship());
+      const bool valid = game->initSweepGame(mSweep->getPoints()[runs[run].point], runs[run].repeat);
+      UTL_assert(valid);
+      (void)valid;
+      game->mNumWorkers = std::min(game->mNumWorkers, mSweepCores);
+      game->initEngine();
+      const size_t cores = game->mNumWorkers;
+
+      std::vector<std::unique_ptr<BattleshipWorkerPool>> stopped;
+      {
+        std::unique_lock<std::mutex> lck(mtx);
+        cv.wait(lck, [&]() { return nextStart == run && freeCores >= cores; });
+        nextStart++;
+        freeCores -= cores;
+        auto pool = std::find_if(idlePools.begin(), idlePools.end(),
+                                 [cores](const std::unique_ptr<BattleshipWorkerPool> &idle) {
+                                   return idle->size() == cores;
+                                 });
+        if (pool != idlePools.end()) {
+          game->mPool = std::move(*pool);
+          idlePools.erase(pool);
+        }
+        else {
+          stopped.swap(idlePools);
+        }
+      }
+      // The next game may fit in what is left
+      cv.notify_all();
+      stopped.clear();
+
+      game->run();
+      const std::string row = describeSweepRun(run, *game);
+      {
+        std::lock_guard<std::mutex> lck(mtx);
+        freeCores += cores;
+        idlePools.push_back(std::move(game->mPool));
+        std::cout << row << std::flush;
+      }
+      cv.notify_all();
+    }
+  };
+
+  std::vector<std::thread> runners;
+  for (size_t i = 0; i < std::min(mSweepCores, runs.size()); ++i) {
+    runners.emplace_back(runner);
+  }
+  for (std::thread &thread : runners) {
+    thread.join();
+  }
+}
+
+
+/****************************************************************
+* describeSweepRun:
+*   aGame's row, in the order of COLUMNS. Scenario names and the
+*   engine and board names never need quoting.
+****************************************************************/
+std::string Battleship::describeSweepRun(size_t aRun, const Battleship &aGame) const {
+  const BattleshipSweep::run_t &run = mSweep->getRuns()[aRun];
+  uint64_t attacks = 0;
+  for (const auto &player : aGame.mPlayers) {
+    const BattleshipPlayer::stats_t stats = player->snapshot();
+    attacks += stats.attacksLaunchedInitialHits + stats.attacksLaunchedInitialMisses
+               + stats.attacksLaunchedSecondaryHits + stats.attacksLaunchedSecondaryMisses;
+  }
+
+  const std::string quote = "\"";
+  const std::string values[] = {
+    quote + mSweep->getScenarioName(mSweep->getPoints()[run.point].scenario) + quote,
+    std::to_string(aRun),
+    std::to_string(run.repeat),
+    std::to_string(aGame.mNumThreads),
+    std::to_string(aGame.mSize),
+    std::to_string(aGame.mTargets),
+    quote + getName(aGame.mEngine) + quote,
+    quote + getName(aGame.mBoards) + quote,
+    std::to_string(aGame.mNumArenas),
+    std::to_string(aGame.mAttackBatch),
+    quote + (aGame.mTryLockTargeting ? "trylock" : "lock") + quote,
+    std::to_string(aGame.mReviveOdds),
+    std::to_string(aGame.mReviveBelow),
+    std::to_string(aGame.mNumWorkers),
+    std::to_string(aGame.mSeed),
+    std::to_string(aGame.mWinner),
+    std::to_string(attacks),
+    std::to_string(aGame.mRevives.load()),
+    std::to_string(aGame.mRounds.size()),
+    std::to_string(seconds(aGame.mInitStartTimePoint, aGame.mInitEndTimePoint)),
+    std::to_string(seconds(aGame.mBattleStartTimePoint, aGame.mBattleEndTimePoint)),
+    std::to_string(seconds(aGame.mInitStartTimePoint, aGame.mBattleEndTimePoint)),
+  };
+  static_assert(sizeof(values) / sizeof(values[0]) == sizeof(COLUMNS) / sizeof(COLUMNS[0]), "A value per column");
+
+  std::string row = mSweepJson ? "{" : "";
+  for (size_t i = 0; i < sizeof(COLUMNS) / sizeof(COLUMNS[0]); ++i) {
+    if (i > 0) {
+      row += ",";
+    }
+    if (mSweepJson) {
+      row += quote + COLUMNS[i] + quote + ":";
+    }
+    row += values[i];
+  }
+  row += mSweepJson ? "}\n" : "\n";
+  return row;
+}
@@ -0,0 +1,107 @@
+/**
+* @Filename: Battleship_Targeting.cpp
+* @Author:   Ben Sokol <Ben>
+* @Email:    ben@bensokol.com
+* @Created:  October 18th, 2026 [6:15pm]
+* @Modified: October 18th, 2026 [9:15pm]
+* @Version:  1.0.0
+*
+* Copyright (C) 2019 by Ben Sokol. All Rights Reserved.
+*/
+
+#include <cstdlib>  // size_t
+#include <mutex>    // std::lock_guard
+#include <string>   // std::to_string
+#include <vector>   // std::vector
+
+#include "TS_logAndPrint.hpp"
+
+#include "Battleship.hpp"
+
+
+/****************************************************************
+* pickOpponent:
+*   A random live opponent from the player's arena, skipping the
+*   players in aAvoid unless only those are left. Caller must hold
+*   the arena lock. Returns NO_PLAYER if every opponent is dead.
+****************************************************************/
+size_t Battleship::pickOpponent(const arena_t &arena, size_t playerNum, const targeting_t *aAvoid) {
+  const std::vector<size_t> &players = arena.players;
+  size_t index = mRngs[playerNum]() % players.size();
+  size_t avoided = NO_PLAYER;
+  for (size_t i = 0; i < players.size(); ++i) {
+    const size_t target = players[index];
+    if (target != playerNum && mPlayers[target]->isAlive()) {
+      if (!aAvoid || !aAvoid->isHot(target)) {
+        return target;
+      }
+      avoided = (avoided == NO_PLAYER) ? target : avoided;
+    }
+    index = (index + 1) % players.size();
+  }
+  return avoided;
+}
+
+
+/****************************************************************
+* tryLockAttack:
+*   Attacks target without holding the arena lock. A target that is
+*   locked is remembered as hot and another opponent is picked, up
+*   to MAX_TRYLOCK_ATTEMPTS times before waiting for the lock.
+*   BattleshipPlayer checks that both players are alive once both
+*   are locked, so a dead player never attacks or is attacked.
+****************************************************************/
+void Battleship::tryLockAttack(size_t playerNum, size_t target, arena_t &arena) {
+  targeting_t &targeting = mTargeting[workerOfPlayer(playerNum)];
+  bool sunk = false;
+  for (size_t attempt = 1;; ++attempt) {
+    targeting.attempts++;
+    if (mPlayers[playerNum]->tryLaunchAttacks(*mPlayers[target], mAttackBatch, &sunk)) {
+      logAndPrint("Player ", playerNum, " attacked player ", target, ".\n");
+      if (sunk) {
+        emitEvent(EVENT_PLAYER_SUNK, target, playerNum);
+      }
+      return;
+    }
+    targeting.failures++;
+    targeting.remember(target);
+    if (attempt == MAX_TRYLOCK_ATTEMPTS) {
+      break;
+    }
+
+    std::lock_guard<std::recursive_mutex> lck(arena.mtx);
+    const size_t next = pickOpponent(arena, playerNum, &targeting);
+    if (next == NO_PLAYER) {
+      // The winner is found on the next turn
+      return;
+    }
+    target = next;
+  }
+
+  targeting.fallbacks++;
+  mPlayers[playerNum]->launchAttacks(*mPlayers[target], mAttackBatch, &sunk);
+  logAndPrint("Player ", playerNum, " waited to attack player ", target, ".\n");
+  if (sunk) {
+    emitEvent(EVENT_PLAYER_SUNK, target, playerNum);
+  }
+}
+
+
+/****************************************************************
+* generateTargetingReport:
+*   Caller must hold the COUT and LOG mutexes.
+****************************************************************/
+void Battleship::generateTargetingReport() {
+  targeting_t total;
+  for (const targeting_t &targeting : mTargeting) {
+    total.attempts += targeting.attempts;
+    total.failures += targeting.failures;
+    total.fallbacks += targeting.fallbacks;
+  }
+  const double rate = total.attempts > 0 ? 100.0 * total.failures / total.attempts : 0.0;
+
+  mReport += "\nTargeting:\n";
+  mReport += "  Try-Lock Attempts:  " + std::to_string(total.attempts) + "\n";
+  mReport += "  Try-Lock Failures:  " + std::to_string(total.failures) + " (" + std::to_string(rate) + "%)\n";
+  mReport += "  Blocking Fallbacks: " + std::to_string(total.fallbacks) + "\n";
+}
@@ -0,0 +1,83 @@
+/**
+* @Filename: Battleship_Tournament.cpp
+* @Author:   Ben Sokol <Ben>
+* @Email:    ben@bensokol.com
+* @Created:  October 18th, 2026 [2:38pm]
+* @Modified: October 18th, 2026 [9:15pm]
+* @Version:  1.0.0
+*
+* Copyright (C) 2019 by Ben Sokol. All Rights Reserved.
+*/
+
+#include <algorithm>  // std::min, std::max
+#include <chrono>     // std::chrono
+#include <cstdlib>    // size_t
+#include <memory>     // std::unique_ptr
+#include <string>     // std::to_string
+#include <vector>     // std::vector
+
+#include "TS_logAndPrint.hpp"
+#include "UTL_assert.h"
+
+#include "Battleship.hpp"
+
+
+/****************************************************************
+* startRound:
+*   Deals the contenders round robin into up to mNumArenas arenas
+*   of at least 2 players. Players that are not contenders sit
+*   the round out.
+****************************************************************/
+void Battleship::startRound(const std::vector<size_t> &contenders) {
+  UTL_assert(!contenders.empty());
+  const size_t arenas = std::max<size_t>(1, std::min(mNumArenas, contenders.size() / 2));
+
+  mArenas.clear();
+  for (size_t i = 0; i < arenas; ++i) {
+    mArenas.emplace_back(new arena_t);
+  }
+  std::fill(mArenaOfPlayer.begin(), mArenaOfPlayer.end(), NO_ARENA);
+  for (size_t i = 0; i < contenders.size(); ++i) {
+    mArenas[i % arenas]->players.push_back(contenders[i]);
+    mArenaOfPlayer[contenders[i]] = i % arenas;
+  }
+  mArenasRemaining.store(arenas);
+
+  if (mNumArenas > 1) {
+    logAndPrintAlways("Round ", mRounds.size() + 1, ": ", contenders.size(), " players in ", arenas, " arenas.\n");
+  }
+  mRounds.push_back({ contenders.size(), arenas, std::chrono::high_resolution_clock::now(), {} });
+}
+
+
+/****************************************************************
+* finishRound:
+*   Returns the arena winners, who contend in the next round.
+****************************************************************/
+std::vector<size_t> Battleship::finishRound() {
+  mRounds.back().endTimePoint = std::chrono::high_resolution_clock::now();
+
+  std::vector<size_t> winners;
+  for (auto &arena : mArenas) {
+    if (arena->done) {
+      winners.push_back(arena->winner);
+    }
+  }
+  return winners;
+}
+
+
+/****************************************************************
+* generateTournamentReport:
+*   Caller must hold the COUT and LOG mutexes.
+****************************************************************/
+void Battleship::generateTournamentReport() {
+  for (size_t i = 0; i < mRounds.size(); ++i) {
+    const round_t &round = mRounds[i];
+    mReport += "  Round " + std::to_string(i + 1) + " (" + std::to_string(round.players) + " players, "
+               + std::to_string(round.arenas) + " arenas) took ";
+    mReport += std::to_string(
+        std::chrono::duration_cast<std::chrono::duration<double>>(round.endTimePoint - round.startTimePoint).count());
+    mReport += " seconds.\n";
+  }
+}
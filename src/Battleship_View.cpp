@@ -0,0 +1,120 @@
+/**
+* @Filename: Battleship_View.cpp
+* @Author:   Ben Sokol <Ben>
+* @Email:    ben@bensokol.com
+* @Created:  October 18th, 2026 [10:55pm]
+* @Modified: October 18th, 2026 [10:55pm]
+* @Version:  1.0.0
+*
+* Copyright (C) 2019 by Ben Sokol. All Rights Reserved.
+*/
+
+#include <chrono>    // std::chrono
+#include <cstdint>   // uint64_t
+#include <cstdlib>   // size_t
+#include <iostream>  // std::cout
+#include <memory>    // std::unique_ptr
+#include <mutex>     // std::unique_lock, std::lock_guard
+#include <string>    // std::string, std::to_string
+#include <vector>    // std::vector
+
+#include "BattleshipView.hpp"
+
+#include "Battleship.hpp"
+
+
+/****************************************************************
+* startView:
+*   Attaches the watched boards, which marks every cell, so the
+*   first frame draws them in full.
+****************************************************************/
+void Battleship::startView() {
+  mView = std::unique_ptr<BattleshipView>(new BattleshipView());
+  for (size_t player : mViewPlayers) {
+    mPlayers[player]->setView(&mView->watch(player, mSize));
+  }
+  mViewThread = std::async(std::launch::async, &Battleship::viewLoop, this);
+}
+
+
+void Battleship::stopView() {
+  {
+    std::lock_guard<std::mutex> lck(mViewMtx);
+    mViewDone = true;
+  }
+  mViewCv.notify_all();
+  mViewThread.wait();
+
+  for (size_t player : mViewPlayers) {
+    mPlayers[player]->setView(nullptr);
+  }
+  mView.reset();
+}
+
+
+/****************************************************************
+* viewLoop:
+*   Players only mark cells, so they never wait on the view. A
+*   frame is built from the marks and published stats, and only
+*   written if something changed. The last frame is drawn after
+*   the battle, then the terminal is restored.
+****************************************************************/
+void Battleship::viewLoop() {
+  const std::chrono::microseconds period(1000000 / mViewFps);
+  std::vector<std::string> labels(mView->getBoardCount());
+  std::string frame = mView->open();
+
+  std::unique_lock<std::mutex> lck(mViewMtx);
+  bool last = false;
+  while (!last) {
+    mViewCv.wait_for(lck, period, [this]() { return mViewDone; });
+    last = mViewDone;
+
+    const auto frameTimePoint = std::chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < labels.size(); ++i) {
+      const size_t player = mView->getBoard(i).getPlayer();
+      const BattleshipPlayer::stats_t stats = mPlayers[player]->snapshot();
+      const std::string label = "Player " + std::to_string(player) + ": "
+                                + (stats.isAlive ? std::to_string(stats.remainingTargets) + " left" : "sunk");
+      if (label != labels[i]) {
+        labels[i] = label;
+        mView->drawLabel(frame, i, label);
+      }
+    }
+    const size_t cells = mView->drawFrame(frame);
+    if (last) {
+      frame += mView->close();
+    }
+    const auto endTimePoint = std::chrono::high_resolution_clock::now();
+
+    if (frame.empty()) {
+      continue;
+    }
+    if (!mSilent) {
+      std::lock_guard<std::recursive_mutex> coutLck(mMtx[COUT]);
+      std::cout << frame << std::flush;
+    }
+    mViewFrames++;
+    mViewCells += cells;
+    mViewBytes += frame.size();
+    mViewNanoseconds += static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(endTimePoint - frameTimePoint).count());
+    frame.clear();
+  }
+}
+
+
+/****************************************************************
+* generateViewReport:
+*   Caller must hold the COUT and LOG mutexes.
+****************************************************************/
+void Battleship::generateViewReport() {
+  mReport += "\nView:\n";
+  mReport += "  Boards: " + std::to_string(mViewPlayers.size()) + " at up to " + std::to_string(mViewFps) + " fps\n";
+  mReport += "  Frames: " + std::to_string(mViewFrames) + ", average "
+             + std::to_string(mViewNanoseconds / mViewFrames / 1000.0) + " µs to build\n";
+  mReport += "  Cells Drawn: " + std::to_string(mViewCells) + " (" + std::to_string(mViewCells / mViewFrames)
+             + " per frame)\n";
+  mReport += "  Bytes Written: " + std::to_string(mViewBytes) + " (" + std::to_string(mViewBytes / mViewFrames)
+             + " per frame)\n";
+}